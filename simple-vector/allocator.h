@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Типичные значения выравнивания буферов для AlignedAllocator
+inline constexpr size_t CACHE_LINE_ALIGNMENT = 64;
+inline constexpr size_t PAGE_ALIGNMENT = 4096;
+
+// Аллокатор по умолчанию для ArrayPtr и SimpleVector: выделяет память при помощи
+// malloc и умеет изменять размер выделенного блока на месте при помощи realloc.
+// Для типов с повышенным выравниванием память выделяется aligned_alloc, а realloc,
+// не сохраняющий выравнивание, заменяется выделением нового блока и копированием
+template <typename Type>
+class MallocAllocator {
+public:
+    using value_type = Type;
+
+    // Гарантированное выравнивание выделенной памяти
+    static constexpr size_t alignment = std::max(alignof(Type), alignof(std::max_align_t));
+
+    MallocAllocator() noexcept = default;
+
+    template <typename Other>
+    MallocAllocator(const MallocAllocator<Other>&) noexcept {
+    }
+
+    // Выделяет неинициализированную память под size элементов типа Type.
+    // При нехватке памяти выбрасывает std::bad_alloc, а если размер в байтах
+    // не помещается в size_t — std::bad_array_new_length
+    Type* allocate(size_t size);
+
+    // Освобождает память, выделенную при помощи allocate или reallocate
+    void deallocate(Type* buf, size_t size) noexcept;
+
+    // Изменяет размер блока buf с old_size до new_size элементов, по возможности на месте.
+    // Содержимое переносится побайтово. При нехватке памяти выбрасывает std::bad_alloc,
+    // а при слишком большом new_size — std::bad_array_new_length, оставляя блок без изменений
+    Type* reallocate(Type* buf, size_t old_size, size_t new_size);
+
+private:
+    // Размер блока под size элементов в байтах, для повышенного выравнивания — кратный
+    // alignment. Если он не помещается в size_t, выбрасывает std::bad_array_new_length
+    static size_t ByteCount(size_t size);
+};
+
+template <typename Type, typename Other>
+bool operator==(const MallocAllocator<Type>&, const MallocAllocator<Other>&) noexcept {
+    return true;
+}
+
+template <typename Type, typename Other>
+bool operator!=(const MallocAllocator<Type>&, const MallocAllocator<Other>&) noexcept {
+    return false;
+}
+
+// Аллокатор, выравнивающий каждый буфер по границе Alignment байт (например,
+// CACHE_LINE_ALIGNMENT или PAGE_ALIGNMENT), чтобы векторизованные циклы могли
+// обходиться без пролога для невыровненных элементов. Метода reallocate нет: realloc
+// не сохраняет выравнивание, поэтому рост всегда выделяет новый выровненный блок
+template <typename Type, size_t Alignment>
+class AlignedAllocator {
+    static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+public:
+    using value_type = Type;
+
+    // Гарантированное выравнивание выделенной памяти
+    static constexpr size_t alignment = std::max(Alignment, alignof(Type));
+
+    template <typename Other>
+    struct rebind {
+        using other = AlignedAllocator<Other, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename Other>
+    AlignedAllocator(const AlignedAllocator<Other, Alignment>&) noexcept {
+    }
+
+    // Выделяет выровненную неинициализированную память под size элементов типа Type.
+    // При нехватке памяти выбрасывает std::bad_alloc, а если размер в байтах
+    // не помещается в size_t — std::bad_array_new_length
+    Type* allocate(size_t size);
+
+    // Освобождает память, выделенную при помощи allocate
+    void deallocate(Type* buf, size_t size) noexcept;
+};
+
+template <typename Type, typename Other, size_t Alignment>
+bool operator==(const AlignedAllocator<Type, Alignment>&, const AlignedAllocator<Other, Alignment>&) noexcept {
+    return true;
+}
+
+template <typename Type, typename Other, size_t Alignment>
+bool operator!=(const AlignedAllocator<Type, Alignment>&, const AlignedAllocator<Other, Alignment>&) noexcept {
+    return false;
+}
+
+// Выравнивание, которое аллокатор гарантирует для каждого буфера: статический член
+// alignment, если он объявлен, иначе выравнивание типа элементов
+template <typename Allocator, typename = void>
+struct GuaranteedAlignment
+    : std::integral_constant<size_t, alignof(typename std::allocator_traits<Allocator>::value_type)> {};
+
+template <typename Allocator>
+struct GuaranteedAlignment<Allocator, std::void_t<decltype(Allocator::alignment)>>
+    : std::integral_constant<size_t, Allocator::alignment> {};
+
+template <typename Allocator>
+inline constexpr size_t GuaranteedAlignmentV = GuaranteedAlignment<Allocator>::value;
+
+// Признак наличия у аллокатора метода reallocate(buf, old_size, new_size),
+// изменяющего размер блока без поэлементного переноса
+template <typename Allocator, typename = void>
+struct HasReallocate : std::false_type {};
+
+template <typename Allocator>
+struct HasReallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+    std::declval<typename std::allocator_traits<Allocator>::pointer>(), size_t{}, size_t{}))>>
+    : std::true_type {};
+
+template <typename Allocator>
+inline constexpr bool HasReallocateV = HasReallocate<Allocator>::value;
+
+// -------------------MallocAllocator-------------------
+
+template <typename Type>
+Type* MallocAllocator<Type>::allocate(size_t size) {
+    void* buf = nullptr;
+    if constexpr (alignof(Type) > alignof(std::max_align_t)) {
+        buf = std::aligned_alloc(alignment, ByteCount(size));
+    }
+    else {
+        buf = std::malloc(ByteCount(size));
+    }
+    if (buf == nullptr) {
+        throw std::bad_alloc();
+    }
+    return static_cast<Type*>(buf);
+}
+
+template <typename Type>
+void MallocAllocator<Type>::deallocate(Type* buf, size_t) noexcept {
+    std::free(buf);
+}
+
+template <typename Type>
+Type* MallocAllocator<Type>::reallocate(Type* buf, size_t old_size, size_t new_size) {
+    if constexpr (alignof(Type) > alignof(std::max_align_t)) {
+        Type* new_buf = allocate(new_size);
+        std::memcpy(static_cast<void*>(new_buf), static_cast<const void*>(buf), std::min(old_size, new_size) * sizeof(Type));
+        deallocate(buf, old_size);
+        return new_buf;
+    }
+    void* new_buf = std::realloc(static_cast<void*>(buf), ByteCount(new_size));
+    if (new_buf == nullptr) {
+        throw std::bad_alloc();
+    }
+    return static_cast<Type*>(new_buf);
+}
+
+template <typename Type>
+size_t MallocAllocator<Type>::ByteCount(size_t size) {
+    constexpr size_t max_bytes = std::numeric_limits<size_t>::max() - (alignment - 1);
+    if (size > max_bytes / sizeof(Type)) {
+        throw std::bad_array_new_length();
+    }
+    if constexpr (alignof(Type) > alignof(std::max_align_t)) {
+        // aligned_alloc требует размер, кратный выравниванию
+        return (size * sizeof(Type) + alignment - 1) / alignment * alignment;
+    }
+    return size * sizeof(Type);
+}
+
+// -------------------AlignedAllocator------------------
+
+template <typename Type, size_t Alignment>
+Type* AlignedAllocator<Type, Alignment>::allocate(size_t size) {
+    if (size > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+        throw std::bad_array_new_length();
+    }
+    return static_cast<Type*>(operator new(size * sizeof(Type), std::align_val_t(alignment)));
+}
+
+template <typename Type, size_t Alignment>
+void AlignedAllocator<Type, Alignment>::deallocate(Type* buf, size_t) noexcept {
+    operator delete(static_cast<void*>(buf), std::align_val_t(alignment));
+}
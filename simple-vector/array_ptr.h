@@ -1,83 +1,145 @@
 #pragma once
 
+#include "allocator.h"
+#include "constexpr_support.h"
+#include "instrumentation.h"
+#include "relocation.h"
+
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 
-template <typename Type>
+// Владеет неинициализированным буфером, выделенным аллокатором Allocator.
+// В константных выражениях (C++20, см. constexpr_support.h) буфер выделяется
+// std::allocator<Type>, так как аллокаторы вектора обычно не constexpr
+template <typename Type, typename Allocator = MallocAllocator<Type>>
 class ArrayPtr {
 public:
+    using AllocatorType = Allocator;
+
     // Инициализирует ArrayPtr нулевым указателем
     ArrayPtr() = default;
 
-    // Создаёт в куче массив из size элементов типа Type.
-    // Если size == 0, поле raw_ptr_ должно быть равно nullptr
-    explicit ArrayPtr(size_t size);
+    // Инициализирует ArrayPtr нулевым указателем и аллокатором alloc
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(const Allocator& alloc) noexcept;
 
-    // Конструктор из сырого указателя, хранящего адрес массива в куче либо nullptr
-    explicit ArrayPtr(Type* raw_ptr) noexcept;
+    // Выделяет при помощи аллокатора неинициализированную память под size элементов типа Type.
+    // Элементы не конструируются: за их создание и разрушение отвечает владелец.
+    // Если size == 0, поле raw_ptr_ должно быть равно nullptr.
+    // Если размер буфера в байтах не помещается в size_t, выбрасывает std::bad_array_new_length
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(size_t size, const Allocator& alloc = Allocator());
+
+    // Конструктор из сырого указателя на память под size элементов, выделенной
+    // аллокатором alloc, либо nullptr
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(Type* raw_ptr, size_t size, const Allocator& alloc = Allocator()) noexcept;
 
     // Запрещаем копирование
     ArrayPtr(const ArrayPtr&) = delete;  
 
-    ArrayPtr(ArrayPtr&& other);
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(ArrayPtr&& other) noexcept;
 
-    ~ArrayPtr();
+    SIMPLE_VECTOR_CONSTEXPR ~ArrayPtr();
 
     // Запрещаем присваивание
     ArrayPtr& operator=(const ArrayPtr&) = delete;
 
-    ArrayPtr& operator=(ArrayPtr&& rhs);
+    // Забирает память и аллокатор rhs
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr& operator=(ArrayPtr&& rhs) noexcept;
 
     // Прекращает владением массивом в памяти, возвращает значение адреса массива
     // После вызова метода указатель на массив должен обнулиться
-    [[nodiscard]] Type* Release() noexcept;
+    [[nodiscard]] SIMPLE_VECTOR_CONSTEXPR Type* Release() noexcept;
 
     // Возвращает ссылку на элемент массива с индексом index
-    Type& operator[](size_t index) noexcept;
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept;
 
     // Возвращает константную ссылку на элемент массива с индексом index
-    const Type& operator[](size_t index) const noexcept;
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept;
 
     // Возвращает true, если указатель ненулевой, и false в противном случае
-    explicit operator bool() const;
+    SIMPLE_VECTOR_CONSTEXPR explicit operator bool() const;
 
     // Возвращает значение сырого указателя, хранящего адрес начала массива
-    Type* Get() const noexcept;
+    SIMPLE_VECTOR_CONSTEXPR Type* Get() const noexcept;
+
+    // Возвращает количество элементов, под которые выделена память
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept;
 
-    // Обменивается значениям указателя на массив с объектом other
-    void Swap(ArrayPtr& other) noexcept;
+    // Возвращает копию аллокатора
+    SIMPLE_VECTOR_CONSTEXPR Allocator GetAllocator() const noexcept;
+
+    // Обменивается значениям указателя на массив и аллокатором с объектом other.
+    // Если аллокатор нельзя присвоить, аллокаторы объектов должны быть равны
+    SIMPLE_VECTOR_CONSTEXPR void Swap(ArrayPtr& other) noexcept;
+
+    // Изменяет размер выделенной памяти до new_size элементов. Если аллокатор
+    // поддерживает reallocate, блок по возможности расширяется на месте.
+    // Содержимое переносится побайтово, поэтому метод допустим только для тривиально
+    // перемещаемых типов. При нехватке памяти выбрасывает исключение,
+    // оставляя массив без изменений
+    void Reallocate(size_t new_size);
     
 private:
+    // Выбрасывает std::bad_array_new_length, если size * sizeof(Type) не помещается в size_t
+    static SIMPLE_VECTOR_CONSTEXPR void CheckSize(size_t size);
+
     Type* raw_ptr_ = nullptr;
+    size_t size_ = 0;
+    Allocator alloc_;
 };
 
-template <typename Type>
-ArrayPtr<Type>::ArrayPtr(size_t size) {
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR ArrayPtr<Type, Allocator>::ArrayPtr(const Allocator& alloc) noexcept
+    : alloc_(alloc) {
+}
+
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR ArrayPtr<Type, Allocator>::ArrayPtr(size_t size, const Allocator& alloc)
+    : alloc_(alloc) {
+    CheckSize(size);
     if (size > 0) {
-        raw_ptr_ = new Type[size];
+        raw_ptr_ = IsConstantEvaluated() ? std::allocator<Type>().allocate(size)
+                                         : std::allocator_traits<Allocator>::allocate(alloc_, size);
+        size_ = size;
+        instrumentation::OnAllocate<Type>(size);
     }
 }
 
-template <typename Type>
-ArrayPtr<Type>::ArrayPtr(Type* raw_ptr) noexcept {
-    raw_ptr_ = raw_ptr;
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR ArrayPtr<Type, Allocator>::ArrayPtr(Type* raw_ptr, size_t size, const Allocator& alloc) noexcept
+    : raw_ptr_(raw_ptr), size_(raw_ptr == nullptr ? 0 : size), alloc_(alloc) {
+    if (raw_ptr_ != nullptr) {
+        instrumentation::OnAllocate<Type>(size_);
+    }
 }
 
-template <typename Type>
-ArrayPtr<Type>::ArrayPtr(ArrayPtr&& other) {
-    ArrayPtr temp(std::exchange(other.raw_ptr_, nullptr));
-    Swap(temp);
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR ArrayPtr<Type, Allocator>::ArrayPtr(ArrayPtr&& other) noexcept
+    : raw_ptr_(std::exchange(other.raw_ptr_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+    , alloc_(std::move(other.alloc_)) {
 }
 
-template <typename Type>
-ArrayPtr<Type>::~ArrayPtr() {
-    delete[] raw_ptr_;
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR ArrayPtr<Type, Allocator>::~ArrayPtr() {
+    if (raw_ptr_ == nullptr) {
+        return;
+    }
+    if (IsConstantEvaluated()) {
+        std::allocator<Type>().deallocate(raw_ptr_, size_);
+        return;
+    }
+    std::allocator_traits<Allocator>::deallocate(alloc_, raw_ptr_, size_);
+    instrumentation::OnDeallocate<Type>(size_);
 }
 
-template <typename Type>
-ArrayPtr<Type>& ArrayPtr<Type>::operator=(ArrayPtr&& rhs) {
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR ArrayPtr<Type, Allocator>& ArrayPtr<Type, Allocator>::operator=(ArrayPtr&& rhs) noexcept {
     if (this->raw_ptr_ != rhs.raw_ptr_) {
         ArrayPtr temp(std::move(rhs));
         Swap(temp);
@@ -85,34 +147,78 @@ ArrayPtr<Type>& ArrayPtr<Type>::operator=(ArrayPtr&& rhs) {
     return *this;
 }
 
-template <typename Type>
-Type* ArrayPtr<Type>::Release() noexcept {
-    auto temp = raw_ptr_;
-    raw_ptr_ = nullptr;
-    return temp;
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR Type* ArrayPtr<Type, Allocator>::Release() noexcept {
+    if (raw_ptr_ != nullptr) {
+        instrumentation::OnDeallocate<Type>(size_);
+    }
+    size_ = 0;
+    return std::exchange(raw_ptr_, nullptr);
 }
 
-template <typename Type>
-Type& ArrayPtr<Type>::operator[](size_t index) noexcept {
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR Type& ArrayPtr<Type, Allocator>::operator[](size_t index) noexcept {
     return raw_ptr_[index];
 }
 
-template <typename Type>
-const Type& ArrayPtr<Type>::operator[](size_t index) const noexcept {
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR const Type& ArrayPtr<Type, Allocator>::operator[](size_t index) const noexcept {
     return raw_ptr_[index];
 }
 
-template <typename Type>
-ArrayPtr<Type>::operator bool() const {
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR ArrayPtr<Type, Allocator>::operator bool() const {
     return raw_ptr_ != nullptr;
 }
 
-template <typename Type>
-Type* ArrayPtr<Type>::Get() const noexcept {
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR Type* ArrayPtr<Type, Allocator>::Get() const noexcept {
     return raw_ptr_;
 }
 
-template <typename Type>
-void ArrayPtr<Type>::Swap(ArrayPtr& other) noexcept {
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR size_t ArrayPtr<Type, Allocator>::GetSize() const noexcept {
+    return size_;
+}
+
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR Allocator ArrayPtr<Type, Allocator>::GetAllocator() const noexcept {
+    return alloc_;
+}
+
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR void ArrayPtr<Type, Allocator>::Swap(ArrayPtr& other) noexcept {
     std::swap(raw_ptr_, other.raw_ptr_);
+    std::swap(size_, other.size_);
+    if constexpr (std::is_move_assignable_v<Allocator>) {
+        std::swap(alloc_, other.alloc_);
+    }
+    else {
+        // Аллокаторы, которые нельзя присвоить, обмениваются только памятью из одного источника
+        assert(alloc_ == other.alloc_);
+    }
+}
+
+template <typename Type, typename Allocator>
+void ArrayPtr<Type, Allocator>::Reallocate(size_t new_size) {
+    CheckSize(new_size);
+    if constexpr (HasReallocateV<Allocator>) {
+        if (raw_ptr_ != nullptr && new_size > 0) {
+            raw_ptr_ = alloc_.reallocate(raw_ptr_, size_, new_size);
+            instrumentation::OnDeallocate<Type>(size_);
+            instrumentation::OnAllocate<Type>(new_size);
+            size_ = new_size;
+            return;
+        }
+    }
+    ArrayPtr temp(new_size, alloc_);
+    RelocateBytes(raw_ptr_, std::min(size_, new_size), temp.Get());
+    Swap(temp);
+}
+
+template <typename Type, typename Allocator>
+SIMPLE_VECTOR_CONSTEXPR void ArrayPtr<Type, Allocator>::CheckSize(size_t size) {
+    if (size > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+        throw std::bad_array_new_length();
+    }
 }
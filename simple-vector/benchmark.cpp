@@ -0,0 +1,521 @@
+// Сравнительный бенчмарк SimpleVector и std::vector.
+// Сборка и запуск:
+//
+//     g++ -std=c++17 -O2 -pthread benchmark.cpp -o benchmark && ./benchmark > results.json
+//
+// Флаг --quick уменьшает число повторений и убирает самый большой размер.
+// Для каждой операции, типа элементов и размера выводится JSON-объект с полями
+// ns_per_op (время на одну операцию), allocations_per_op (выделений памяти контейнером
+// на операцию) и bytes_copied_per_op (байт элементов, скопированных или перемещённых
+// контейнером, на операцию). Копирования считаются в отдельном прогоне без замера
+// времени, где элементы обёрнуты в Tracked: обёртка не тривиально перемещаема, поэтому
+// побайтовый перенос и расширение блока realloc на месте учитываются как поэлементный перенос.
+// Единица операции указана в поле unit: element — один добавленный, удалённый,
+// скопированный, сравнённый или пройденный элемент, call — один вызов метода
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Счётчики выделений памяти и копирований элементов за время замера
+struct AllocationStats {
+    size_t allocations = 0;
+    size_t bytes_copied = 0;
+};
+
+inline AllocationStats allocation_stats;
+
+// Аллокатор, считающий выделения памяти контейнером
+template <typename Type, typename Base>
+class CountingAllocator {
+public:
+    using value_type = Type;
+    using is_always_equal = std::true_type;
+
+    template <typename Other>
+    struct rebind {
+        using other = CountingAllocator<Other, typename std::allocator_traits<Base>::template rebind_alloc<Other>>;
+    };
+
+    CountingAllocator() noexcept = default;
+
+    template <typename Other, typename OtherBase>
+    CountingAllocator(const CountingAllocator<Other, OtherBase>&) noexcept {
+    }
+
+    Type* allocate(size_t size) {
+        ++allocation_stats.allocations;
+        return base_.allocate(size);
+    }
+
+    void deallocate(Type* buf, size_t size) noexcept {
+        base_.deallocate(buf, size);
+    }
+
+    template <typename B = Base, typename = std::enable_if_t<HasReallocateV<B>>>
+    Type* reallocate(Type* buf, size_t old_size, size_t new_size) {
+        ++allocation_stats.allocations;
+        return base_.reallocate(buf, old_size, new_size);
+    }
+
+private:
+    Base base_;
+};
+
+template <typename Type, typename Base, typename Other, typename OtherBase>
+bool operator==(const CountingAllocator<Type, Base>&, const CountingAllocator<Other, OtherBase>&) noexcept {
+    return true;
+}
+
+template <typename Type, typename Base, typename Other, typename OtherBase>
+bool operator!=(const CountingAllocator<Type, Base>&, const CountingAllocator<Other, OtherBase>&) noexcept {
+    return false;
+}
+
+template <typename Type>
+using BenchSimpleVector = SimpleVector<Type, CountingAllocator<Type, MallocAllocator<Type>>>;
+
+template <typename Type>
+using BenchStdVector = std::vector<Type, CountingAllocator<Type, std::allocator<Type>>>;
+
+// ----------------------Типы элементов----------------------
+
+// Тривиально копируемая структура размером в кэш-линию
+struct Pod64 {
+    uint64_t words[8];
+};
+
+bool operator==(const Pod64& lhs, const Pod64& rhs) {
+    return std::equal(std::begin(lhs.words), std::end(lhs.words), std::begin(rhs.words));
+}
+
+bool operator<(const Pod64& lhs, const Pod64& rhs) {
+    return std::lexicographical_compare(std::begin(lhs.words), std::end(lhs.words),
+                                        std::begin(rhs.words), std::end(rhs.words));
+}
+
+// Некопируемый тип с перемещением, как X из tests.h
+class X {
+public:
+    X()
+        : X(5) {
+    }
+    X(size_t num)
+        : x_(num) {
+    }
+    X(const X& other) = delete;
+    X& operator=(const X& other) = delete;
+    X(X&& other) {
+        x_ = std::exchange(other.x_, 0);
+    }
+    X& operator=(X&& other) {
+        x_ = std::exchange(other.x_, 0);
+        return *this;
+    }
+    size_t GetX() const {
+        return x_;
+    }
+
+private:
+    size_t x_;
+};
+
+// Обёртка, засчитывающая каждое копирование и перемещение элемента в bytes_copied.
+// Создание из готового значения не засчитывается. Операции копирования и перемещения
+// создаются компилятором, поэтому доступность и noexcept у них те же, что у Type
+template <typename Type>
+class Tracked {
+public:
+    Tracked() = default;
+    explicit Tracked(Type value)
+        : value_(std::move(value)) {
+    }
+    const Type& Get() const {
+        return value_;
+    }
+
+private:
+    // Копируется и «перемещается» вместе со значением, засчитывая его размер
+    struct Counter {
+        Counter() = default;
+        Counter(const Counter&) noexcept {
+            allocation_stats.bytes_copied += sizeof(Type);
+        }
+        Counter& operator=(const Counter&) noexcept {
+            allocation_stats.bytes_copied += sizeof(Type);
+            return *this;
+        }
+    };
+
+    Type value_{};
+    Counter counter_;
+};
+
+template <typename Type>
+bool operator==(const Tracked<Type>& lhs, const Tracked<Type>& rhs) {
+    return lhs.Get() == rhs.Get();
+}
+
+template <typename Type>
+bool operator<(const Tracked<Type>& lhs, const Tracked<Type>& rhs) {
+    return lhs.Get() < rhs.Get();
+}
+
+template <typename Type>
+struct IsTracked : std::false_type {};
+
+template <typename Type>
+struct IsTracked<Tracked<Type>> : std::true_type {};
+
+template <typename Container>
+using ElementOf = std::decay_t<decltype(*std::declval<Container&>().begin())>;
+
+template <typename Type>
+Type MakeElement(size_t i) {
+    if constexpr (IsTracked<Type>::value) {
+        return Type(MakeElement<std::decay_t<decltype(std::declval<Type>().Get())>>(i));
+    }
+    else if constexpr (std::is_same_v<Type, int>) {
+        return static_cast<int>(i);
+    }
+    else if constexpr (std::is_same_v<Type, Pod64>) {
+        return Pod64{{i, i, i, i, i, i, i, i}};
+    }
+    else if constexpr (std::is_same_v<Type, std::string>) {
+        // Строка длиннее буфера SSO, чтобы копирование выделяло память
+        std::string result = "element-" + std::to_string(i);
+        result.resize(24, '#');
+        return result;
+    }
+    else {
+        return Type(i);
+    }
+}
+
+template <typename Type>
+uint64_t ElementKey(const Type& value) {
+    if constexpr (IsTracked<Type>::value) {
+        return ElementKey(value.Get());
+    }
+    else if constexpr (std::is_same_v<Type, int>) {
+        return static_cast<uint64_t>(value);
+    }
+    else if constexpr (std::is_same_v<Type, Pod64>) {
+        return value.words[0];
+    }
+    else if constexpr (std::is_same_v<Type, std::string>) {
+        return value.size() + static_cast<unsigned char>(value[8]);
+    }
+    else {
+        return value.GetX();
+    }
+}
+
+template <typename Type>
+const char* TypeName() {
+    if constexpr (std::is_same_v<Type, int>) {
+        return "int";
+    }
+    else if constexpr (std::is_same_v<Type, Pod64>) {
+        return "pod64";
+    }
+    else if constexpr (std::is_same_v<Type, std::string>) {
+        return "std::string";
+    }
+    else {
+        return "X";
+    }
+}
+
+// ------------Единый интерфейс двух контейнеров-------------
+
+template <typename Type, typename... Rest>
+void PushBack(SimpleVector<Type, Rest...>& container, Type&& value) {
+    container.PushBack(std::move(value));
+}
+
+template <typename Type, typename Alloc>
+void PushBack(std::vector<Type, Alloc>& container, Type&& value) {
+    container.push_back(std::move(value));
+}
+
+template <typename Type, typename... Rest>
+void Insert(SimpleVector<Type, Rest...>& container, size_t index, Type&& value) {
+    container.Insert(container.begin() + index, std::move(value));
+}
+
+template <typename Type, typename Alloc>
+void Insert(std::vector<Type, Alloc>& container, size_t index, Type&& value) {
+    container.insert(container.begin() + index, std::move(value));
+}
+
+template <typename Type, typename... Rest>
+void Erase(SimpleVector<Type, Rest...>& container, size_t index) {
+    container.Erase(container.begin() + index);
+}
+
+template <typename Type, typename Alloc>
+void Erase(std::vector<Type, Alloc>& container, size_t index) {
+    container.erase(container.begin() + index);
+}
+
+template <typename Type, typename... Rest>
+void Reserve(SimpleVector<Type, Rest...>& container, size_t capacity) {
+    container.Reserve(capacity);
+}
+
+template <typename Type, typename Alloc>
+void Reserve(std::vector<Type, Alloc>& container, size_t capacity) {
+    container.reserve(capacity);
+}
+
+template <typename Type, typename... Rest>
+void Resize(SimpleVector<Type, Rest...>& container, size_t size) {
+    container.Resize(size);
+}
+
+template <typename Type, typename Alloc>
+void Resize(std::vector<Type, Alloc>& container, size_t size) {
+    container.resize(size);
+}
+
+template <typename Type, typename... Rest>
+size_t Size(const SimpleVector<Type, Rest...>& container) {
+    return container.GetSize();
+}
+
+template <typename Type, typename Alloc>
+size_t Size(const std::vector<Type, Alloc>& container) {
+    return container.size();
+}
+
+template <typename Container>
+Container MakeFilled(size_t size) {
+    Container container;
+    Reserve(container, size);
+    for (size_t i = 0; i < size; ++i) {
+        PushBack(container, MakeElement<ElementOf<Container>>(i));
+    }
+    return container;
+}
+
+// -------------------------Замеры---------------------------
+
+// Не даёт компилятору выбросить вычисление value
+template <typename Type>
+void DoNotOptimize(const Type& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct Measurement {
+    double ns_per_op = 0;
+    double allocations_per_op = 0;
+    double bytes_copied_per_op = 0;
+};
+
+// Повторяет замер reps раз: setup() готовит состояние вне замера, op(state) выполняет
+// ops операций. Состояние разрушается после остановки таймера
+template <typename Setup, typename Op>
+Measurement Measure(size_t reps, size_t ops, Setup setup, Op op) {
+    using Clock = std::chrono::steady_clock;
+    double total_ns = 0;
+    size_t allocations = 0;
+    size_t bytes_copied = 0;
+    for (size_t rep = 0; rep < reps; ++rep) {
+        auto state = setup();
+        allocation_stats = {};
+        const auto start = Clock::now();
+        op(state);
+        const auto finish = Clock::now();
+        allocations += allocation_stats.allocations;
+        bytes_copied += allocation_stats.bytes_copied;
+        total_ns += std::chrono::duration<double, std::nano>(finish - start).count();
+    }
+    const double total_ops = static_cast<double>(reps * std::max(ops, size_t{1}));
+    return {total_ns / total_ops, allocations / total_ops, bytes_copied / total_ops};
+}
+
+// Выполняет одну операцию над обоими контейнерами и печатает результат
+class Reporter {
+public:
+    Reporter(std::ostream& out, size_t budget)
+        : out_(out), budget_(budget) {
+    }
+
+    // bench(Container{}, reps) возвращает Measurement для указанного контейнера.
+    // Время и выделения замеряются с элементами Type, копирования — одним прогоном
+    // с элементами Tracked<Type>
+    template <typename Type, typename Bench>
+    void Run(std::string_view operation, std::string_view unit, size_t size, size_t work_per_rep, Bench bench) {
+        const size_t reps = std::clamp(budget_ / std::max(work_per_rep, size_t{1}), size_t{3}, size_t{10000});
+        Measurement simple = bench(BenchSimpleVector<Type>{}, reps);
+        simple.bytes_copied_per_op = bench(BenchSimpleVector<Tracked<Type>>{}, 1).bytes_copied_per_op;
+        Measurement standard = bench(BenchStdVector<Type>{}, reps);
+        standard.bytes_copied_per_op = bench(BenchStdVector<Tracked<Type>>{}, 1).bytes_copied_per_op;
+        out_ << (first_ ? "\n" : ",\n");
+        first_ = false;
+        out_ << "    {\"operation\": \"" << operation << "\", \"type\": \"" << TypeName<Type>()
+             << "\", \"size\": " << size << ", \"unit\": \"" << unit << "\", \"repetitions\": " << reps
+             << ", \"simple_vector\": ";
+        Print(simple);
+        out_ << ", \"std_vector\": ";
+        Print(standard);
+        out_ << "}";
+    }
+
+private:
+    std::ostream& out_;
+    size_t budget_;
+    bool first_ = true;
+
+    void Print(const Measurement& m) {
+        out_ << "{\"ns_per_op\": " << m.ns_per_op << ", \"allocations_per_op\": " << m.allocations_per_op
+             << ", \"bytes_copied_per_op\": " << m.bytes_copied_per_op << "}";
+    }
+};
+
+// Количество вставок и удалений в середине вектора за одно повторение
+inline constexpr size_t EDIT_COUNT = 64;
+
+template <typename Type>
+void RunTypeBenchmarks(Reporter& reporter, size_t size) {
+    reporter.Run<Type>("PushBack/cold", "element", size, size, [size](auto tag, size_t reps) {
+        using Container = decltype(tag);
+        return Measure(reps, size, [] { return Container{}; }, [size](Container& c) {
+            for (size_t i = 0; i < size; ++i) {
+                PushBack(c, MakeElement<ElementOf<Container>>(i));
+            }
+        });
+    });
+    reporter.Run<Type>("PushBack/reserved", "element", size, size, [size](auto tag, size_t reps) {
+        using Container = decltype(tag);
+        return Measure(reps, size, [size] {
+            Container c;
+            Reserve(c, size);
+            return c;
+        }, [size](Container& c) {
+            for (size_t i = 0; i < size; ++i) {
+                PushBack(c, MakeElement<ElementOf<Container>>(i));
+            }
+        });
+    });
+
+    const std::pair<const char*, int> positions[] = {{"front", 0}, {"middle", 1}, {"back", 2}};
+    const size_t edits = std::min(size, EDIT_COUNT);
+    for (const auto& [name, position] : positions) {
+        auto index = [position](size_t current_size) {
+            return position == 0 ? 0 : position == 1 ? current_size / 2 : current_size;
+        };
+        reporter.Run<Type>(std::string("Insert/") + name, "element", size, size * edits, [&](auto tag, size_t reps) {
+            using Container = decltype(tag);
+            return Measure(reps, edits, [size] { return MakeFilled<Container>(size); }, [&](Container& c) {
+                for (size_t i = 0; i < edits; ++i) {
+                    Insert(c, index(Size(c)), MakeElement<ElementOf<Container>>(i));
+                }
+            });
+        });
+        reporter.Run<Type>(std::string("Erase/") + name, "element", size, size * edits, [&](auto tag, size_t reps) {
+            using Container = decltype(tag);
+            return Measure(reps, edits, [size] { return MakeFilled<Container>(size); }, [&](Container& c) {
+                for (size_t i = 0; i < edits; ++i) {
+                    Erase(c, std::min(index(Size(c)), Size(c) - 1));
+                }
+            });
+        });
+    }
+
+    reporter.Run<Type>("Reserve", "element", size, size, [size](auto tag, size_t reps) {
+        using Container = decltype(tag);
+        return Measure(reps, size, [size] { return MakeFilled<Container>(size); }, [size](Container& c) {
+            Reserve(c, size * 2);
+        });
+    });
+    reporter.Run<Type>("Resize", "element", size, size, [size](auto tag, size_t reps) {
+        using Container = decltype(tag);
+        return Measure(reps, size, [] { return Container{}; }, [size](Container& c) {
+            Resize(c, size);
+        });
+    });
+    reporter.Run<Type>("Move", "call", size, size, [size](auto tag, size_t reps) {
+        using Container = decltype(tag);
+        return Measure(reps, 1, [size] {
+            return std::make_pair(MakeFilled<Container>(size), std::optional<Container>());
+        }, [](auto& state) {
+            state.second.emplace(std::move(state.first));
+        });
+    });
+    reporter.Run<Type>("Iterate", "element", size, size, [size](auto tag, size_t reps) {
+        using Container = decltype(tag);
+        return Measure(reps, size, [size] { return MakeFilled<Container>(size); }, [](Container& c) {
+            uint64_t sum = 0;
+            for (const auto& value : c) {
+                sum += ElementKey(value);
+            }
+            DoNotOptimize(sum);
+        });
+    });
+
+    if constexpr (std::is_copy_constructible_v<Type>) {
+        reporter.Run<Type>("Copy", "element", size, size, [size](auto tag, size_t reps) {
+            using Container = decltype(tag);
+            return Measure(reps, size, [size] {
+                return std::make_pair(MakeFilled<Container>(size), std::optional<Container>());
+            }, [](auto& state) {
+                state.second.emplace(state.first);
+            });
+        });
+        reporter.Run<Type>("Compare/equal", "element", size, size, [size](auto tag, size_t reps) {
+            using Container = decltype(tag);
+            return Measure(reps, size, [size] {
+                return std::make_pair(MakeFilled<Container>(size), MakeFilled<Container>(size));
+            }, [](auto& state) {
+                const bool equal = state.first == state.second;
+                DoNotOptimize(equal);
+            });
+        });
+        reporter.Run<Type>("Compare/less", "element", size, size, [size](auto tag, size_t reps) {
+            using Container = decltype(tag);
+            return Measure(reps, size, [size] {
+                return std::make_pair(MakeFilled<Container>(size), MakeFilled<Container>(size));
+            }, [](auto& state) {
+                const bool less = state.first < state.second;
+                DoNotOptimize(less);
+            });
+        });
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const bool quick = argc > 1 && std::string_view(argv[1]) == "--quick";
+    const size_t budget = quick ? (size_t{1} << 18) : (size_t{1} << 22);
+    SimpleVector<size_t> sizes = {16, 1024, 65536};
+    if (!quick) {
+        sizes.PushBack(size_t{1} << 20);
+    }
+
+    std::cout << "{\n  \"benchmark\": \"SimpleVector vs std::vector\",\n  \"results\": [";
+    Reporter reporter(std::cout, budget);
+    for (const size_t size : sizes) {
+        RunTypeBenchmarks<int>(reporter, size);
+        RunTypeBenchmarks<Pod64>(reporter, size);
+        RunTypeBenchmarks<std::string>(reporter, size);
+        RunTypeBenchmarks<X>(reporter, size);
+    }
+    std::cout << "\n  ]\n}\n";
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Выученная подсказка вместимости для векторов, которые многократно создаются в одном
+// месте и каждый раз вырастают примерно до одного размера. Подсказка помнит итоговые
+// размеры последних HISTORY_SIZE векторов и предсказывает наибольший из них, поэтому
+// новый вектор сразу получает нужную вместимость вместо роста через 1, 2, 4, ...
+// Подсказкой можно пользоваться из нескольких потоков одновременно.
+// Итоговый размер записывает CapacityRecorder при выходе из области видимости,
+// в том числе при раннем возврате и исключении:
+//
+//     CapacityHint& hint = SIMPLE_VECTOR_CAPACITY_HINT();
+//     SimpleVector<int> v(Reserve(hint));
+//     CapacityRecorder recorder(hint, v);
+//     ...
+class CapacityHint {
+public:
+    // Количество запоминаемых итоговых размеров
+    static constexpr size_t HISTORY_SIZE = 8;
+
+    CapacityHint() noexcept = default;
+
+    CapacityHint(const CapacityHint&) = delete;
+    CapacityHint& operator=(const CapacityHint&) = delete;
+
+    // Возвращает предсказанную вместимость: наибольший из запомненных размеров,
+    // либо 0, пока размеры не записывались
+    size_t Predict() const noexcept;
+
+    // Запоминает итоговый размер вектора, вытесняя самый старый
+    void Record(size_t final_size) noexcept;
+
+    template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+    void Record(const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& vector) noexcept;
+
+    // Забывает запомненные размеры
+    void Reset() noexcept;
+
+private:
+    std::atomic<size_t> sizes_[HISTORY_SIZE] = {};
+    std::atomic<size_t> next_ = 0;
+};
+
+// Записывает в подсказку размер вектора при разрушении. Вектор должен жить дольше
+// записывающего объекта, поэтому объект создаётся после вектора. Если вектор перемещается
+// из области видимости (например, возвращается без NRVO), размер записывается до
+// перемещения явным вызовом CapacityHint::Record, а записывающий объект отключается Dismiss
+template <typename Vector>
+class CapacityRecorder {
+public:
+    CapacityRecorder(CapacityHint& hint, const Vector& vector) noexcept;
+
+    CapacityRecorder(const CapacityRecorder&) = delete;
+    CapacityRecorder& operator=(const CapacityRecorder&) = delete;
+
+    ~CapacityRecorder();
+
+    // Отменяет запись размера при разрушении
+    void Dismiss() noexcept;
+
+private:
+    CapacityHint* hint_;
+    const Vector& vector_;
+};
+
+// Возвращает прокси-объект для конструктора SimpleVector с вместимостью, предсказанной hint
+inline ReserveProxyObj Reserve(const CapacityHint& hint) {
+    return ReserveProxyObj(hint.Predict());
+}
+
+// Возвращает подсказку, общую для всех мест программы, использующих тег tag.
+// Подсказки не разрушаются до завершения программы
+CapacityHint& GetCapacityHint(std::string_view tag);
+
+// Подсказка, своя для каждого места в коде, где записан макрос
+#define SIMPLE_VECTOR_CAPACITY_HINT() \
+    ([]() -> CapacityHint& {          \
+        static CapacityHint hint;     \
+        return hint;                  \
+    }())
+
+// -------------------CapacityHint-------------------
+
+inline size_t CapacityHint::Predict() const noexcept {
+    size_t result = 0;
+    for (const auto& size : sizes_) {
+        result = std::max(result, size.load(std::memory_order_relaxed));
+    }
+    return result;
+}
+
+inline void CapacityHint::Record(size_t final_size) noexcept {
+    const size_t slot = next_.fetch_add(1, std::memory_order_relaxed) % HISTORY_SIZE;
+    sizes_[slot].store(final_size, std::memory_order_relaxed);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+void CapacityHint::Record(const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& vector) noexcept {
+    Record(vector.GetSize());
+}
+
+inline void CapacityHint::Reset() noexcept {
+    for (auto& size : sizes_) {
+        size.store(0, std::memory_order_relaxed);
+    }
+    next_.store(0, std::memory_order_relaxed);
+}
+
+// -----------------CapacityRecorder-----------------
+
+template <typename Vector>
+CapacityRecorder<Vector>::CapacityRecorder(CapacityHint& hint, const Vector& vector) noexcept
+    : hint_(&hint), vector_(vector) {
+}
+
+template <typename Vector>
+CapacityRecorder<Vector>::~CapacityRecorder() {
+    if (hint_ != nullptr) {
+        hint_->Record(vector_.GetSize());
+    }
+}
+
+template <typename Vector>
+void CapacityRecorder<Vector>::Dismiss() noexcept {
+    hint_ = nullptr;
+}
+
+inline CapacityHint& GetCapacityHint(std::string_view tag) {
+    static std::mutex mutex;
+    // Не разрушается, чтобы статические объекты могли пользоваться подсказками при завершении
+    static auto* hints = new std::map<std::string, std::unique_ptr<CapacityHint>, std::less<>>();
+    std::lock_guard lock(mutex);
+    auto it = hints->find(tag);
+    if (it == hints->end()) {
+        it = hints->emplace(std::string(tag), std::make_unique<CapacityHint>()).first;
+    }
+    return *it->second;
+}
@@ -0,0 +1,366 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Вектор для одновременного добавления элементов из нескольких потоков.
+// Элементы хранятся в сегментах, размеры которых растут степенями двойки: сегмент k
+// вмещает FIRST_SEGMENT_SIZE * 2^k элементов. Сегменты никогда не перемещаются, поэтому
+// адреса элементов и их индексы стабильны, а рост не переносит уже добавленные элементы.
+// PushBack и EmplaceBack свободны от блокировок: индекс занимается атомарным CAS,
+// недостающий сегмент устанавливается CAS, а готовность элемента отмечается флагом.
+// Элемент считается опубликованным, когда он и все элементы до него созданы: GetPublishedSize
+// возвращает длину этого префикса, и снимок (GetSnapshot) обходит только его.
+// Элемент, индекс которого вернул PushBack, можно читать в том же потоке сразу;
+// в других потоках — после того как он опубликован или TryGet вернул не nullptr.
+// Разрушение вектора не должно выполняться одновременно с другими вызовами
+template <typename Type>
+class ConcurrentSimpleVector {
+public:
+    // Размер первого сегмента
+    static constexpr size_t FIRST_SEGMENT_SIZE = 8;
+
+    class Snapshot;
+
+    ConcurrentSimpleVector() noexcept = default;
+
+    ConcurrentSimpleVector(const ConcurrentSimpleVector&) = delete;
+    ConcurrentSimpleVector& operator=(const ConcurrentSimpleVector&) = delete;
+
+    ~ConcurrentSimpleVector();
+
+    // Добавляет элемент в конец вектора и возвращает его индекс
+    size_t PushBack(const Type& item);
+
+    size_t PushBack(Type&& item);
+
+    // Создаёт элемент из аргументов args в конце вектора и возвращает его индекс.
+    // Если конструктор выбрасывает исключение, индекс не занимается
+    template <typename... Args>
+    size_t EmplaceBack(Args&&... args);
+
+    // Заранее выделяет сегменты под capacity элементов
+    void Reserve(size_t capacity);
+
+    // Возвращает количество занятых индексов, включая элементы, которые ещё создаются
+    size_t GetSize() const noexcept;
+
+    // Возвращает длину префикса полностью созданных элементов
+    size_t GetPublishedSize() const noexcept;
+
+    // Возвращает ссылку на элемент с индексом index. Элемент должен быть создан
+    // и виден вызывающему потоку
+    Type& operator[](size_t index) noexcept;
+
+    const Type& operator[](size_t index) const noexcept;
+
+    // Возвращает указатель на элемент с индексом index, если он уже создан, иначе nullptr
+    const Type* TryGet(size_t index) const noexcept;
+
+    // Возвращает снимок опубликованных элементов. Элементы, добавленные позже, в него не входят
+    Snapshot GetSnapshot() const noexcept;
+
+    // Копирует опубликованные элементы в SimpleVector
+    SimpleVector<Type> ToSimpleVector() const;
+
+private:
+    static constexpr size_t FIRST_SEGMENT_BITS = 3;
+    static constexpr size_t SEGMENT_COUNT = 64 - FIRST_SEGMENT_BITS;
+    static constexpr size_t ALIGNMENT = std::max(alignof(Type), alignof(std::max_align_t));
+
+    static_assert(FIRST_SEGMENT_SIZE == size_t{1} << FIRST_SEGMENT_BITS);
+
+    // Сегмент: элементы, за которыми следуют флаги их готовности
+    std::atomic<Type*> segments_[SEGMENT_COUNT] = {};
+    std::atomic<size_t> size_ = 0;
+    std::atomic<size_t> published_ = 0;
+
+    static size_t GetSegmentSize(size_t segment) noexcept;
+
+    // Возвращает номер сегмента и смещение в нём для индекса index
+    static std::pair<size_t, size_t> Locate(size_t index) noexcept;
+
+    static std::atomic<bool>* GetFlags(Type* segment_data, size_t segment) noexcept;
+
+    // Выделяет сегмент segment, если он ещё не выделен. Возвращает его данные
+    Type* EnsureSegment(size_t segment);
+
+    // Занимает следующий индекс, предварительно выделив его сегмент
+    size_t ClaimIndex();
+
+    // Отмечает элемент index созданным и продвигает границу опубликованного префикса
+    void Publish(size_t index) noexcept;
+
+    bool IsReady(size_t index) const noexcept;
+};
+
+// Снимок опубликованного префикса ConcurrentSimpleVector
+template <typename Type>
+class ConcurrentSimpleVector<Type>::Snapshot {
+public:
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Type*;
+        using reference = const Type&;
+
+        ConstIterator() noexcept = default;
+
+        reference operator*() const noexcept {
+            return (*vector_)[index_];
+        }
+
+        pointer operator->() const noexcept {
+            return &(*vector_)[index_];
+        }
+
+        ConstIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        ConstIterator operator++(int) noexcept {
+            ConstIterator result = *this;
+            ++index_;
+            return result;
+        }
+
+        bool operator==(const ConstIterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const ConstIterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+    private:
+        friend class Snapshot;
+
+        const ConcurrentSimpleVector* vector_ = nullptr;
+        size_t index_ = 0;
+
+        ConstIterator(const ConcurrentSimpleVector* vector, size_t index) noexcept
+            : vector_(vector), index_(index) {
+        }
+    };
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return (*vector_)[index];
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(vector_, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(vector_, size_);
+    }
+
+private:
+    friend class ConcurrentSimpleVector;
+
+    const ConcurrentSimpleVector* vector_;
+    size_t size_;
+
+    Snapshot(const ConcurrentSimpleVector* vector, size_t size) noexcept
+        : vector_(vector), size_(size) {
+    }
+};
+
+// --------------ConcurrentSimpleVector--------------
+
+template <typename Type>
+ConcurrentSimpleVector<Type>::~ConcurrentSimpleVector() {
+    const size_t size = size_.load(std::memory_order_acquire);
+    for (size_t index = 0; index < size; ++index) {
+        if (IsReady(index)) {
+            (*this)[index].~Type();
+        }
+    }
+    for (size_t segment = 0; segment < SEGMENT_COUNT; ++segment) {
+        Type* data = segments_[segment].load(std::memory_order_acquire);
+        if (data != nullptr) {
+            ::operator delete(static_cast<void*>(data), std::align_val_t(ALIGNMENT));
+        }
+    }
+}
+
+template <typename Type>
+size_t ConcurrentSimpleVector<Type>::PushBack(const Type& item) {
+    return EmplaceBack(item);
+}
+
+template <typename Type>
+size_t ConcurrentSimpleVector<Type>::PushBack(Type&& item) {
+    return EmplaceBack(std::move(item));
+}
+
+template <typename Type>
+template <typename... Args>
+size_t ConcurrentSimpleVector<Type>::EmplaceBack(Args&&... args) {
+    if constexpr (std::is_nothrow_constructible_v<Type, Args&&...>) {
+        const size_t index = ClaimIndex();
+        new (&(*this)[index]) Type(std::forward<Args>(args)...);
+        Publish(index);
+        return index;
+    }
+    else {
+        static_assert(std::is_nothrow_move_constructible_v<Type>,
+                      "Type must be nothrow constructible from args or nothrow move constructible");
+        // Занятый индекс нельзя вернуть, поэтому всё, что может выбросить исключение,
+        // выполняется до его занятия
+        Type item(std::forward<Args>(args)...);
+        const size_t index = ClaimIndex();
+        new (&(*this)[index]) Type(std::move(item));
+        Publish(index);
+        return index;
+    }
+}
+
+template <typename Type>
+void ConcurrentSimpleVector<Type>::Reserve(size_t capacity) {
+    if (capacity == 0) {
+        return;
+    }
+    const size_t last_segment = Locate(capacity - 1).first;
+    for (size_t segment = 0; segment <= last_segment; ++segment) {
+        EnsureSegment(segment);
+    }
+}
+
+template <typename Type>
+size_t ConcurrentSimpleVector<Type>::GetSize() const noexcept {
+    return size_.load(std::memory_order_acquire);
+}
+
+template <typename Type>
+size_t ConcurrentSimpleVector<Type>::GetPublishedSize() const noexcept {
+    return published_.load(std::memory_order_acquire);
+}
+
+template <typename Type>
+Type& ConcurrentSimpleVector<Type>::operator[](size_t index) noexcept {
+    const auto [segment, offset] = Locate(index);
+    return segments_[segment].load(std::memory_order_acquire)[offset];
+}
+
+template <typename Type>
+const Type& ConcurrentSimpleVector<Type>::operator[](size_t index) const noexcept {
+    const auto [segment, offset] = Locate(index);
+    return segments_[segment].load(std::memory_order_acquire)[offset];
+}
+
+template <typename Type>
+const Type* ConcurrentSimpleVector<Type>::TryGet(size_t index) const noexcept {
+    return index < GetSize() && IsReady(index) ? &(*this)[index] : nullptr;
+}
+
+template <typename Type>
+typename ConcurrentSimpleVector<Type>::Snapshot ConcurrentSimpleVector<Type>::GetSnapshot() const noexcept {
+    return Snapshot(this, GetPublishedSize());
+}
+
+template <typename Type>
+SimpleVector<Type> ConcurrentSimpleVector<Type>::ToSimpleVector() const {
+    const Snapshot snapshot = GetSnapshot();
+    SimpleVector<Type> result(::Reserve(snapshot.GetSize()));
+    for (const Type& item : snapshot) {
+        result.PushBack(item);
+    }
+    return result;
+}
+
+template <typename Type>
+size_t ConcurrentSimpleVector<Type>::GetSegmentSize(size_t segment) noexcept {
+    return FIRST_SEGMENT_SIZE << segment;
+}
+
+template <typename Type>
+std::pair<size_t, size_t> ConcurrentSimpleVector<Type>::Locate(size_t index) noexcept {
+    const size_t position = index + FIRST_SEGMENT_SIZE;
+#if defined(__GNUC__) || defined(__clang__)
+    const size_t high_bit = 63 - static_cast<size_t>(__builtin_clzll(position));
+#else
+    size_t high_bit = 0;
+    while ((position >> (high_bit + 1)) != 0) {
+        ++high_bit;
+    }
+#endif
+    const size_t segment = high_bit - FIRST_SEGMENT_BITS;
+    return {segment, position - GetSegmentSize(segment)};
+}
+
+template <typename Type>
+std::atomic<bool>* ConcurrentSimpleVector<Type>::GetFlags(Type* segment_data, size_t segment) noexcept {
+    return reinterpret_cast<std::atomic<bool>*>(reinterpret_cast<unsigned char*>(segment_data)
+                                                + GetSegmentSize(segment) * sizeof(Type));
+}
+
+template <typename Type>
+Type* ConcurrentSimpleVector<Type>::EnsureSegment(size_t segment) {
+    Type* data = segments_[segment].load(std::memory_order_acquire);
+    if (data != nullptr) {
+        return data;
+    }
+    const size_t size = GetSegmentSize(segment);
+    void* block = ::operator new(size * sizeof(Type) + size * sizeof(std::atomic<bool>), std::align_val_t(ALIGNMENT));
+    Type* new_data = static_cast<Type*>(block);
+    std::atomic<bool>* flags = GetFlags(new_data, segment);
+    for (size_t i = 0; i < size; ++i) {
+        new (flags + i) std::atomic<bool>(false);
+    }
+    if (segments_[segment].compare_exchange_strong(data, new_data, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return new_data;
+    }
+    // Сегмент уже установил другой поток
+    ::operator delete(block, std::align_val_t(ALIGNMENT));
+    return data;
+}
+
+template <typename Type>
+size_t ConcurrentSimpleVector<Type>::ClaimIndex() {
+    size_t index = size_.load(std::memory_order_relaxed);
+    while (true) {
+        EnsureSegment(Locate(index).first);
+        if (size_.compare_exchange_weak(index, index + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return index;
+        }
+    }
+}
+
+template <typename Type>
+void ConcurrentSimpleVector<Type>::Publish(size_t index) noexcept {
+    const auto [segment, offset] = Locate(index);
+    GetFlags(segments_[segment].load(std::memory_order_acquire), segment)[offset].store(true, std::memory_order_seq_cst);
+    // Каждый поток продвигает границу префикса, пока элементы за ней готовы, поэтому
+    // граница доходит до конца без ожидания медленных потоков
+    size_t published = published_.load(std::memory_order_seq_cst);
+    while (published < size_.load(std::memory_order_seq_cst) && IsReady(published)) {
+        if (published_.compare_exchange_weak(published, published + 1, std::memory_order_seq_cst)) {
+            ++published;
+        }
+    }
+}
+
+template <typename Type>
+bool ConcurrentSimpleVector<Type>::IsReady(size_t index) const noexcept {
+    const auto [segment, offset] = Locate(index);
+    Type* data = segments_[segment].load(std::memory_order_acquire);
+    return data != nullptr && GetFlags(data, segment)[offset].load(std::memory_order_seq_cst);
+}
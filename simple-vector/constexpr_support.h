@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Поддержка вычисления SimpleVector в константных выражениях (C++20).
+// Если компилятор и стандартная библиотека допускают временное выделение памяти
+// в константных выражениях (std::allocator, std::construct_at), SIMPLE_VECTOR_CONSTEXPR
+// раскрывается в constexpr, а SIMPLE_VECTOR_HAS_CONSTEXPR — в 1, иначе — в пустоту и 0,
+// и код остаётся обычным C++17.
+// При вычислении константного выражения (IsConstantEvaluated) память выделяется
+// std::allocator вместо аллокатора вектора, побайтовые переносы заменяются
+// поэлементными, а SIMD, потоки и счётчики не используются.
+// Память, выделенная при компиляции, должна быть освобождена в том же константном
+// выражении, поэтому таблицу вычисляют вектором и копируют в std::array:
+//
+//     constexpr auto TABLE = [] {
+//         SimpleVector<int> v;
+//         ...
+//         std::array<int, N> result{};
+//         std::copy(v.begin(), v.end(), result.begin());
+//         return result;
+//     }();
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc)
+#define SIMPLE_VECTOR_HAS_CONSTEXPR 1
+#define SIMPLE_VECTOR_CONSTEXPR constexpr
+#else
+#define SIMPLE_VECTOR_HAS_CONSTEXPR 0
+#define SIMPLE_VECTOR_CONSTEXPR
+#endif
+
+// Сообщает, вычисляется ли вызов в константном выражении
+constexpr bool IsConstantEvaluated() noexcept {
+#ifdef __cpp_lib_is_constant_evaluated
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// Создаёт объект Type из args в неинициализированной памяти place
+template <typename Type, typename... Args>
+SIMPLE_VECTOR_CONSTEXPR Type* ConstructAt(Type* place, Args&&... args) {
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+    return std::construct_at(place, std::forward<Args>(args)...);
+#else
+    return ::new (static_cast<void*>(place)) Type(std::forward<Args>(args)...);
+#endif
+}
+
+// Аналоги алгоритмов std::uninitialized_*, допустимые в константных выражениях.
+// Во время выполнения программы вызывают алгоритмы стандартной библиотеки.
+// Исключение в константном выражении само делает его ошибкой компиляции,
+// поэтому поэлементные циклы не разрушают созданное
+
+template <typename InputIt, typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* UninitializedCopy(InputIt first, InputIt last, Type* dest) {
+    if (IsConstantEvaluated()) {
+        for (; first != last; ++first, ++dest) {
+            ConstructAt(dest, *first);
+        }
+        return dest;
+    }
+    return std::uninitialized_copy(first, last, dest);
+}
+
+template <typename InputIt, typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* UninitializedCopyN(InputIt first, size_t count, Type* dest) {
+    if (IsConstantEvaluated()) {
+        for (; count > 0; --count, ++first, ++dest) {
+            ConstructAt(dest, *first);
+        }
+        return dest;
+    }
+    return std::uninitialized_copy_n(first, count, dest);
+}
+
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* UninitializedMoveN(Type* first, size_t count, Type* dest) {
+    if (IsConstantEvaluated()) {
+        for (; count > 0; --count, ++first, ++dest) {
+            ConstructAt(dest, std::move(*first));
+        }
+        return dest;
+    }
+    return std::uninitialized_move_n(first, count, dest).second;
+}
+
+template <typename Type, typename Value>
+SIMPLE_VECTOR_CONSTEXPR Type* UninitializedFillN(Type* dest, size_t count, const Value& value) {
+    if (IsConstantEvaluated()) {
+        for (; count > 0; --count, ++dest) {
+            ConstructAt(dest, value);
+        }
+        return dest;
+    }
+    return std::uninitialized_fill_n(dest, count, value);
+}
+
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedValueConstruct(Type* first, Type* last) {
+    if (IsConstantEvaluated()) {
+        for (; first != last; ++first) {
+            ConstructAt(first);
+        }
+        return;
+    }
+    std::uninitialized_value_construct(first, last);
+}
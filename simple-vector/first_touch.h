@@ -0,0 +1,116 @@
+#pragma once
+
+#include "allocator.h"
+#include "constexpr_support.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+// Объём памяти в байтах, начиная с которого элементы создаются несколькими потоками.
+// Порог можно переопределить макросом SIMPLE_VECTOR_PARALLEL_INIT_THRESHOLD до подключения заголовка
+#ifndef SIMPLE_VECTOR_PARALLEL_INIT_THRESHOLD
+#define SIMPLE_VECTOR_PARALLEL_INIT_THRESHOLD (size_t{16} << 20)
+#endif
+
+inline constexpr size_t PARALLEL_INIT_THRESHOLD = SIMPLE_VECTOR_PARALLEL_INIT_THRESHOLD;
+
+// Наименьший объём памяти, ради которого запускается ещё один поток
+inline constexpr size_t PARALLEL_INIT_BYTES_PER_THREAD = size_t{4} << 20;
+
+// Признак того, что элементы типа Type можно создавать несколькими потоками одновременно:
+// конструкторы типа не обращаются к общему неатомарному состоянию.
+// По умолчанию выполняется только для тривиальных типов. Для собственных типов
+// с потокобезопасными конструкторами признак можно включить специализацией:
+//
+//     template <>
+//     struct IsParallelConstructible<MyType> : std::true_type {};
+template <typename Type>
+struct IsParallelConstructible
+    : std::bool_constant<std::is_trivially_default_constructible_v<Type> && std::is_trivially_copyable_v<Type>> {};
+
+template <typename Type>
+inline constexpr bool IsParallelConstructibleV = IsParallelConstructible<Type>::value;
+
+namespace first_touch_detail {
+
+// Создаёт элементы частями по одному потоку на часть (см. ParallelUninitializedConstruct)
+template <typename Type, typename Construct>
+void ConstructInParts(Type* dest, size_t count, size_t part_count, Construct& construct) {
+    // Границы частей кратны странице, чтобы каждую страницу затрагивал только один поток
+    const size_t page_elements = std::max(PAGE_ALIGNMENT / sizeof(Type), size_t{1});
+    const size_t part_size = ((count + part_count - 1) / part_count + page_elements - 1) / page_elements * page_elements;
+    auto bound = [count, part_size](size_t part) {
+        return std::min(part * part_size, count);
+    };
+
+    std::unique_ptr<std::exception_ptr[]> errors(new std::exception_ptr[part_count]);
+    auto run = [&](size_t part) noexcept {
+        try {
+            construct(bound(part), bound(part + 1));
+        } catch (...) {
+            errors[part] = std::current_exception();
+        }
+    };
+
+    std::unique_ptr<std::thread[]> threads(new std::thread[part_count - 1]);
+    size_t started = 0;
+    for (; started + 1 < part_count; ++started) {
+        try {
+            threads[started] = std::thread(run, started + 1);
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+    run(0);
+    // Части, для которых не удалось запустить поток, создаются вызывающим потоком
+    for (size_t part = started + 1; part < part_count; ++part) {
+        run(part);
+    }
+    for (size_t i = 0; i < started; ++i) {
+        threads[i].join();
+    }
+
+    for (size_t failed = 0; failed < part_count; ++failed) {
+        if (errors[failed]) {
+            for (size_t part = 0; part < part_count; ++part) {
+                if (!errors[part]) {
+                    std::destroy(dest + bound(part), dest + bound(part + 1));
+                }
+            }
+            std::rethrow_exception(errors[failed]);
+        }
+    }
+}
+
+} // namespace first_touch_detail
+
+// Создаёт count элементов в неинициализированной памяти dest, вызывая construct(first, last)
+// для непересекающихся частей [first, last). construct должен создать элементы dest[first, last),
+// а при исключении сам разрушить созданное (как это делают алгоритмы std::uninitialized_*).
+// Большие массивы делятся на части по границам страниц, и каждую часть создаёт свой поток:
+// страницы впервые затрагиваются этим потоком и размещаются ближе к нему, а запись идёт
+// со скоростью памяти, а не одного ядра. Если хотя бы одна часть выбросила исключение,
+// остальные части разрушаются, и первое по порядку исключение выбрасывается повторно.
+// Параллельно создаются только элементы типов с IsParallelConstructibleV<Type>,
+// остальные, как и в константном выражении, создаются вызывающим потоком
+template <typename Type, typename Construct>
+SIMPLE_VECTOR_CONSTEXPR void ParallelUninitializedConstruct(Type* dest, size_t count, Construct construct) {
+    if constexpr (!IsParallelConstructibleV<Type>) {
+        construct(size_t{0}, count);
+        return;
+    }
+    const size_t bytes = count * sizeof(Type);
+    const size_t part_count = IsConstantEvaluated() || bytes < PARALLEL_INIT_THRESHOLD
+        ? 1
+        : std::min<size_t>(std::thread::hardware_concurrency(), bytes / PARALLEL_INIT_BYTES_PER_THREAD);
+    if (part_count < 2) {
+        construct(size_t{0}, count);
+        return;
+    }
+    first_touch_detail::ConstructInParts(dest, count, part_count, construct);
+}
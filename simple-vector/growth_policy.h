@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+// Политики роста вместимости SimpleVector.
+// Политика предоставляет статический метод NextCapacity(capacity, required, element_size),
+// возвращающий новую вместимость не меньше required для вектора вместимостью capacity
+// с элементами размером element_size байт. Политика применяется при росте в PushBack,
+// Insert, Emplace, Append и Resize; явный вызов Reserve выделяет ровно запрошенную вместимость.
+// Метод, объявленный constexpr, позволяет вычислять вектор в константных выражениях
+
+// Удваивает вместимость, для пустого вектора выделяет место под один элемент
+struct DoublingGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept;
+};
+
+// Увеличивает вместимость в полтора раза. Расходует меньше памяти, чем удвоение,
+// ценой большего числа перевыделений
+struct OneAndHalfGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept;
+};
+
+// Округляет вместимость, выбранную политикой Base, так, чтобы буфер занимал целое число
+// страниц размером PageSize. Округление применяется только к буферам не меньше страницы
+template <typename Base = DoublingGrowth, size_t PageSize = 4096>
+struct PageRoundedGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept;
+};
+
+// Округляет размер буфера, выбранный политикой Base, до ближайшего размерного класса
+// типичного аллокатора (jemalloc, tcmalloc): четыре класса на каждое удвоение размера.
+// Память, которую аллокатор всё равно выделил бы, становится доступной вместимостью
+template <typename Base = DoublingGrowth>
+struct BucketAlignedGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept;
+};
+
+// -------------------DoublingGrowth-------------------
+
+constexpr size_t DoublingGrowth::NextCapacity(size_t capacity, size_t required, size_t) noexcept {
+    return std::max(capacity == 0 ? size_t{1} : capacity * 2, required);
+}
+
+// ------------------OneAndHalfGrowth------------------
+
+constexpr size_t OneAndHalfGrowth::NextCapacity(size_t capacity, size_t required, size_t) noexcept {
+    return std::max(capacity + std::max(capacity / 2, size_t{1}), required);
+}
+
+// -----------------PageRoundedGrowth------------------
+
+template <typename Base, size_t PageSize>
+constexpr size_t PageRoundedGrowth<Base, PageSize>::NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+    const size_t base_capacity = Base::NextCapacity(capacity, required, element_size);
+    const size_t bytes = base_capacity * element_size;
+    if (bytes < PageSize) {
+        return base_capacity;
+    }
+    const size_t rounded_bytes = (bytes + PageSize - 1) / PageSize * PageSize;
+    return rounded_bytes / element_size;
+}
+
+// ----------------BucketAlignedGrowth-----------------
+
+template <typename Base>
+constexpr size_t BucketAlignedGrowth<Base>::NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+    const size_t base_capacity = Base::NextCapacity(capacity, required, element_size);
+    const size_t bytes = base_capacity * element_size;
+    constexpr size_t min_bucket = 16;
+    if (bytes <= min_bucket) {
+        return std::max(min_bucket / element_size, base_capacity);
+    }
+    // Шаг классов размером от 2^k до 2^(k+1) равен 2^(k-2)
+    size_t power = min_bucket;
+    while (power * 2 < bytes) {
+        power *= 2;
+    }
+    const size_t step = power / 4;
+    const size_t rounded_bytes = (bytes + step - 1) / step * step;
+    return rounded_bytes / element_size;
+}
@@ -0,0 +1,465 @@
+#pragma once
+
+#include "array_ptr.h"
+#include "growth_policy.h"
+#include "instrumentation.h"
+#include "relocation.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Вектор с постепенным ростом для кода, которому важна задержка каждого добавления.
+// При нехватке места SimpleVector переносит все элементы в новый буфер за один вызов
+// PushBack. IncrementalSimpleVector вместо этого выделяет новый буфер и оставляет старый:
+// каждый следующий PushBack переносит часть элементов, пока перенос не закончится.
+// Пока идёт перенос, элементы [migrated, old_size) лежат в старом буфере, а остальные —
+// в новом по тем же индексам; operator[] и итераторы учитывают это, но сами элементы
+// не образуют непрерывного массива. Ссылки на элементы остаются действительными,
+// пока элемент не перенесён; перенос выполняют только изменяющие методы.
+// За один PushBack переносится не менее MigrationStep элементов. Чтобы перенос успевал
+// закончиться до следующего роста, при росте с old_size до new_capacity шаг увеличивается
+// до ceil(old_size / (new_capacity - old_size)): для DoublingGrowth он остаётся равным
+// MigrationStep, для OneAndHalfGrowth — не больше max(MigrationStep, 3). Время PushBack
+// ограничено сверху и не зависит от размера вектора, если политика увеличивает вместимость
+// в постоянное число раз; при росте на постоянную величину шаг растёт вместе с размером
+template <typename Type, typename Allocator = MallocAllocator<Type>, typename GrowthPolicy = DoublingGrowth,
+          size_t MigrationStep = 16>
+class IncrementalSimpleVector {
+    static_assert(MigrationStep > 0, "MigrationStep must be positive");
+
+public:
+    template <typename Value>
+    class BasicIterator;
+
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+
+    IncrementalSimpleVector() noexcept = default;
+    explicit IncrementalSimpleVector(const Allocator& alloc) noexcept;
+
+    IncrementalSimpleVector(const IncrementalSimpleVector&) = delete;
+    IncrementalSimpleVector& operator=(const IncrementalSimpleVector&) = delete;
+
+    IncrementalSimpleVector(IncrementalSimpleVector&& other) noexcept;
+    IncrementalSimpleVector& operator=(IncrementalSimpleVector&& rhs) noexcept;
+
+    ~IncrementalSimpleVector();
+
+    size_t GetSize() const noexcept;
+    size_t GetCapacity() const noexcept;
+    bool IsEmpty() const noexcept;
+
+    // Сообщает, что перенос элементов из старого буфера ещё не закончен
+    bool IsGrowing() const noexcept;
+
+    // Добавляет элемент в конец вектора. Переносит не более migration_step_ элементов
+    void PushBack(const Type& item);
+
+    void PushBack(Type&& item);
+
+    // Создаёт элемент из аргументов args в конце вектора и возвращает ссылку на него.
+    // Переносит не более migration_step_ элементов
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args);
+
+    // Удаляет последний элемент. Вектор не должен быть пустым
+    void PopBack() noexcept;
+
+    // Разрушает все элементы, вместимость сохраняется
+    void Clear() noexcept;
+
+    // Заканчивает перенос и увеличивает вместимость до new_capacity за один вызов
+    void Reserve(size_t new_capacity);
+
+    // Переносит все оставшиеся элементы из старого буфера и освобождает его
+    void FinishGrowth();
+
+    Type& operator[](size_t index) noexcept;
+    const Type& operator[](size_t index) const noexcept;
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index);
+    const Type& At(size_t index) const;
+
+    Iterator begin() noexcept;
+    Iterator end() noexcept;
+    ConstIterator begin() const noexcept;
+    ConstIterator end() const noexcept;
+    ConstIterator cbegin() const noexcept;
+    ConstIterator cend() const noexcept;
+
+private:
+    // Основной буфер вместимостью capacity_
+    ArrayPtr<Type, Allocator> data_;
+    // Старый буфер, из которого ещё переносятся элементы [migrated_, old_size_)
+    ArrayPtr<Type, Allocator> old_data_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    size_t migrated_ = 0;
+    size_t old_size_ = 0;
+    // Число элементов, переносимых за один PushBack при текущем росте
+    size_t migration_step_ = MigrationStep;
+
+    // Возвращает адрес элемента index в том буфере, где он сейчас находится
+    Type* Locate(size_t index) const noexcept;
+
+    // Переносит до count элементов из старого буфера в основной
+    void Migrate(size_t count);
+
+    // Освобождает старый буфер, если в нём не осталось элементов
+    void ReleaseOldIfDone() noexcept;
+};
+
+// Итератор произвольного доступа по индексу элемента
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+template <typename Value>
+class IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::BasicIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    BasicIterator() noexcept = default;
+
+    // Итератор преобразуется в константный
+    template <typename Other, typename = std::enable_if_t<std::is_convertible_v<Other*, Value*>>>
+    BasicIterator(const BasicIterator<Other>& other) noexcept
+        : vector_(other.vector_), index_(other.index_) {
+    }
+
+    reference operator*() const noexcept {
+        return *vector_->Locate(index_);
+    }
+
+    pointer operator->() const noexcept {
+        return vector_->Locate(index_);
+    }
+
+    reference operator[](difference_type offset) const noexcept {
+        return *vector_->Locate(index_ + offset);
+    }
+
+    BasicIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+        BasicIterator result = *this;
+        ++index_;
+        return result;
+    }
+
+    BasicIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    BasicIterator operator--(int) noexcept {
+        BasicIterator result = *this;
+        --index_;
+        return result;
+    }
+
+    BasicIterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+
+    BasicIterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+
+    friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+
+    friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+        return it += offset;
+    }
+
+    friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+
+    friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+private:
+    friend class IncrementalSimpleVector;
+
+    template <typename Other>
+    friend class BasicIterator;
+
+    const IncrementalSimpleVector* vector_ = nullptr;
+    size_t index_ = 0;
+
+    BasicIterator(const IncrementalSimpleVector* vector, size_t index) noexcept
+        : vector_(vector), index_(index) {
+    }
+};
+
+// --------------IncrementalSimpleVector--------------
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::IncrementalSimpleVector(const Allocator& alloc) noexcept
+    : data_(alloc), old_data_(alloc) {
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::IncrementalSimpleVector(IncrementalSimpleVector&& other) noexcept
+    : data_(std::move(other.data_))
+    , old_data_(std::move(other.old_data_))
+    , size_(std::exchange(other.size_, 0))
+    , capacity_(std::exchange(other.capacity_, 0))
+    , migrated_(std::exchange(other.migrated_, 0))
+    , old_size_(std::exchange(other.old_size_, 0))
+    , migration_step_(std::exchange(other.migration_step_, MigrationStep)) {
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::operator=(IncrementalSimpleVector&& rhs) noexcept {
+    if (this != &rhs) {
+        Clear();
+        data_ = std::move(rhs.data_);
+        old_data_ = std::move(rhs.old_data_);
+        size_ = std::exchange(rhs.size_, 0);
+        capacity_ = std::exchange(rhs.capacity_, 0);
+        migrated_ = std::exchange(rhs.migrated_, 0);
+        old_size_ = std::exchange(rhs.old_size_, 0);
+        migration_step_ = std::exchange(rhs.migration_step_, MigrationStep);
+    }
+    return *this;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::~IncrementalSimpleVector() {
+    Clear();
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+size_t IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::GetSize() const noexcept {
+    return size_;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+size_t IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::GetCapacity() const noexcept {
+    return capacity_;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+bool IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::IsEmpty() const noexcept {
+    return size_ == 0;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+bool IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::IsGrowing() const noexcept {
+    return static_cast<bool>(old_data_);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+void IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::PushBack(const Type& item) {
+    EmplaceBack(item);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+void IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::PushBack(Type&& item) {
+    EmplaceBack(std::move(item));
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+template <typename... Args>
+Type& IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::EmplaceBack(Args&&... args) {
+    if (size_ == capacity_) {
+        // Шаг переноса рассчитан так, что перенос уже закончен; он может остаться
+        // незаконченным, только если предыдущий перенос выбросил исключение
+        FinishGrowth();
+        const size_t new_capacity = GrowthPolicy::NextCapacity(capacity_, size_ + 1, sizeof(Type));
+        // До следующего роста, включая этот вызов, будет new_capacity - size_ добавлений
+        const size_t pushes = new_capacity - size_;
+        migration_step_ = std::max(MigrationStep, (size_ + pushes - 1) / pushes);
+        ArrayPtr<Type, Allocator> new_data(new_capacity, data_.GetAllocator());
+        // Старый буфер остаётся живым, поэтому args могут ссылаться на элементы вектора
+        new (new_data.Get() + size_) Type(std::forward<Args>(args)...);
+        instrumentation::OnReallocate<Type>(size_);
+        old_data_.Swap(data_);
+        data_.Swap(new_data);
+        capacity_ = new_capacity;
+        migrated_ = 0;
+        old_size_ = size_;
+    }
+    else {
+        new (data_.Get() + size_) Type(std::forward<Args>(args)...);
+    }
+    ++size_;
+    if (IsGrowing()) {
+        try {
+            Migrate(migration_step_);
+        } catch (...) {
+            --size_;
+            data_[size_].~Type();
+            throw;
+        }
+    }
+    return data_[size_ - 1];
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+void IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::PopBack() noexcept {
+    assert(size_ != 0);
+    --size_;
+    Locate(size_)->~Type();
+    old_size_ = std::min(old_size_, size_);
+    ReleaseOldIfDone();
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+void IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::Clear() noexcept {
+    while (size_ > 0) {
+        PopBack();
+    }
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+void IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::Reserve(size_t new_capacity) {
+    FinishGrowth();
+    if (new_capacity <= capacity_) {
+        return;
+    }
+    ArrayPtr<Type, Allocator> new_data(new_capacity, data_.GetAllocator());
+    UninitializedRelocate(data_.Get(), size_, new_data.Get());
+    if constexpr (!IsTriviallyRelocatableV<Type>) {
+        std::destroy_n(data_.Get(), size_);
+    }
+    instrumentation::OnReallocate<Type>(size_);
+    data_.Swap(new_data);
+    capacity_ = new_capacity;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+void IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::FinishGrowth() {
+    if (IsGrowing()) {
+        Migrate(old_size_ - migrated_);
+    }
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+Type& IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return *Locate(index);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+const Type& IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return *Locate(index);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+Type& IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::At(size_t index) {
+    if (!(index < size_))
+        throw std::out_of_range("The index value is out of range");
+    return *Locate(index);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+const Type& IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::At(size_t index) const {
+    if (!(index < size_))
+        throw std::out_of_range("The index value is out of range");
+    return *Locate(index);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+typename IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::Iterator IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::begin() noexcept {
+    return Iterator(this, 0);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+typename IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::Iterator IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::end() noexcept {
+    return Iterator(this, size_);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+typename IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::ConstIterator IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::begin() const noexcept {
+    return ConstIterator(this, 0);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+typename IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::ConstIterator IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::end() const noexcept {
+    return ConstIterator(this, size_);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+typename IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::ConstIterator IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+typename IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::ConstIterator IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::cend() const noexcept {
+    return end();
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+Type* IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::Locate(size_t index) const noexcept {
+    // Один беззнаковый сдвиг проверяет migrated_ <= index < old_size_
+    if (index - migrated_ < old_size_ - migrated_) {
+        return old_data_.Get() + index;
+    }
+    return data_.Get() + index;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+void IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::Migrate(size_t count) {
+    count = std::min(count, old_size_ - migrated_);
+    // При исключении перенесённые в этот раз копии разрушаются, и состояние не меняется
+    UninitializedRelocate(old_data_.Get() + migrated_, count, data_.Get() + migrated_);
+    if constexpr (!IsTriviallyRelocatableV<Type>) {
+        std::destroy_n(old_data_.Get() + migrated_, count);
+    }
+    migrated_ += count;
+    ReleaseOldIfDone();
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+void IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>::ReleaseOldIfDone() noexcept {
+    if (IsGrowing() && migrated_ >= old_size_) {
+        ArrayPtr<Type, Allocator> empty(old_data_.GetAllocator());
+        old_data_.Swap(empty);
+        migrated_ = 0;
+        old_size_ = 0;
+    }
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "constexpr_support.h"
+
+#include <atomic>
+#include <cstddef>
+
+// Счётчики выделений памяти и переносов элементов ArrayPtr и SimpleVector.
+// Включаются макросом SIMPLE_VECTOR_INSTRUMENTATION, который должен быть одинаково
+// определён (или не определён) до подключения заголовков во всех единицах трансляции.
+// Без макроса хуки пусты, и компилятор полностью удаляет их вызовы.
+// Векторы, вычисляемые в константных выражениях, не учитываются.
+// Счётчики ведутся отдельно для каждого типа элементов и суммарно для всех типов
+#ifdef SIMPLE_VECTOR_INSTRUMENTATION
+inline constexpr bool INSTRUMENTATION_ENABLED = true;
+#else
+inline constexpr bool INSTRUMENTATION_ENABLED = false;
+#endif
+
+// Снимок счётчиков
+struct VectorStats {
+    // Количество выделений памяти под буферы (включая reallocate)
+    size_t allocations = 0;
+
+    // Количество освобождений буферов (включая reallocate)
+    size_t deallocations = 0;
+
+    // Суммарный объём выделенной и освобождённой памяти в байтах
+    size_t bytes_allocated = 0;
+    size_t bytes_deallocated = 0;
+
+    // Количество замен буфера вектора при росте, Reserve и возврате памяти
+    size_t reallocations = 0;
+
+    // Количество элементов, перенесённых в новый буфер при замене буфера
+    size_t elements_relocated = 0;
+
+    // Количество элементов, сдвинутых внутри буфера при вставке и удалении
+    size_t elements_shifted = 0;
+
+    // Наибольший размер одного буфера в байтах
+    size_t peak_capacity_bytes = 0;
+
+    // Возвращает объём памяти, занятой буферами в момент снимка
+    size_t GetBytesInUse() const noexcept {
+        return bytes_allocated - bytes_deallocated;
+    }
+};
+
+namespace instrumentation {
+
+// Набор атомарных счётчиков. Обновляется из любых потоков без блокировок
+class Counters {
+public:
+    void OnAllocate(size_t bytes) noexcept;
+
+    void OnDeallocate(size_t bytes) noexcept;
+
+    void OnReallocate(size_t elements) noexcept;
+
+    void OnShift(size_t elements) noexcept;
+
+    VectorStats Load() const noexcept;
+
+    void Reset() noexcept;
+
+private:
+    std::atomic<size_t> allocations_ = 0;
+    std::atomic<size_t> deallocations_ = 0;
+    std::atomic<size_t> bytes_allocated_ = 0;
+    std::atomic<size_t> bytes_deallocated_ = 0;
+    std::atomic<size_t> reallocations_ = 0;
+    std::atomic<size_t> elements_relocated_ = 0;
+    std::atomic<size_t> elements_shifted_ = 0;
+    std::atomic<size_t> peak_capacity_bytes_ = 0;
+};
+
+inline Counters& GlobalCounters() noexcept {
+    static Counters counters;
+    return counters;
+}
+
+template <typename Type>
+Counters& TypeCounters() noexcept {
+    static Counters counters;
+    return counters;
+}
+
+// Выделен буфер под count элементов
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void OnAllocate(size_t count) noexcept {
+    if constexpr (INSTRUMENTATION_ENABLED) {
+        if (IsConstantEvaluated()) {
+            return;
+        }
+        TypeCounters<Type>().OnAllocate(count * sizeof(Type));
+        GlobalCounters().OnAllocate(count * sizeof(Type));
+    }
+}
+
+// Освобождён буфер под count элементов
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void OnDeallocate(size_t count) noexcept {
+    if constexpr (INSTRUMENTATION_ENABLED) {
+        if (IsConstantEvaluated()) {
+            return;
+        }
+        TypeCounters<Type>().OnDeallocate(count * sizeof(Type));
+        GlobalCounters().OnDeallocate(count * sizeof(Type));
+    }
+}
+
+// Буфер вектора заменён новым, в который перенесено count элементов
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void OnReallocate(size_t count) noexcept {
+    if constexpr (INSTRUMENTATION_ENABLED) {
+        if (IsConstantEvaluated()) {
+            return;
+        }
+        TypeCounters<Type>().OnReallocate(count);
+        GlobalCounters().OnReallocate(count);
+    }
+}
+
+// count элементов сдвинуто внутри буфера
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void OnShift(size_t count) noexcept {
+    if constexpr (INSTRUMENTATION_ENABLED) {
+        if (IsConstantEvaluated()) {
+            return;
+        }
+        TypeCounters<Type>().OnShift(count);
+        GlobalCounters().OnShift(count);
+    }
+}
+
+} // namespace instrumentation
+
+// Возвращает счётчики векторов с элементами типа Type
+template <typename Type>
+VectorStats GetVectorStats() noexcept {
+    return instrumentation::TypeCounters<Type>().Load();
+}
+
+// Возвращает счётчики всех векторов
+inline VectorStats GetGlobalVectorStats() noexcept {
+    return instrumentation::GlobalCounters().Load();
+}
+
+// Обнуляет счётчики векторов с элементами типа Type. Общие счётчики не изменяются
+template <typename Type>
+void ResetVectorStats() noexcept {
+    instrumentation::TypeCounters<Type>().Reset();
+}
+
+// Обнуляет общие счётчики. Счётчики отдельных типов не изменяются
+inline void ResetGlobalVectorStats() noexcept {
+    instrumentation::GlobalCounters().Reset();
+}
+
+// ---------------instrumentation::Counters---------------
+
+namespace instrumentation {
+
+inline void Counters::OnAllocate(size_t bytes) noexcept {
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+    size_t peak = peak_capacity_bytes_.load(std::memory_order_relaxed);
+    while (peak < bytes && !peak_capacity_bytes_.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+    }
+}
+
+inline void Counters::OnDeallocate(size_t bytes) noexcept {
+    deallocations_.fetch_add(1, std::memory_order_relaxed);
+    bytes_deallocated_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+inline void Counters::OnReallocate(size_t elements) noexcept {
+    reallocations_.fetch_add(1, std::memory_order_relaxed);
+    elements_relocated_.fetch_add(elements, std::memory_order_relaxed);
+}
+
+inline void Counters::OnShift(size_t elements) noexcept {
+    elements_shifted_.fetch_add(elements, std::memory_order_relaxed);
+}
+
+inline VectorStats Counters::Load() const noexcept {
+    VectorStats stats;
+    stats.allocations = allocations_.load(std::memory_order_relaxed);
+    stats.deallocations = deallocations_.load(std::memory_order_relaxed);
+    stats.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+    stats.bytes_deallocated = bytes_deallocated_.load(std::memory_order_relaxed);
+    stats.reallocations = reallocations_.load(std::memory_order_relaxed);
+    stats.elements_relocated = elements_relocated_.load(std::memory_order_relaxed);
+    stats.elements_shifted = elements_shifted_.load(std::memory_order_relaxed);
+    stats.peak_capacity_bytes = peak_capacity_bytes_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+inline void Counters::Reset() noexcept {
+    allocations_.store(0, std::memory_order_relaxed);
+    deallocations_.store(0, std::memory_order_relaxed);
+    bytes_allocated_.store(0, std::memory_order_relaxed);
+    bytes_deallocated_.store(0, std::memory_order_relaxed);
+    reallocations_.store(0, std::memory_order_relaxed);
+    elements_relocated_.store(0, std::memory_order_relaxed);
+    elements_shifted_.store(0, std::memory_order_relaxed);
+    peak_capacity_bytes_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace instrumentation
@@ -19,4 +19,28 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestUninitializedCapacity();
+    TestTriviallyRelocatable();
+    TestMoveAssignmentStealsBuffer();
+    TestEmplace();
+    TestAllocator();
+    TestSmallSimpleVector();
+    TestRangeOperations();
+    TestGrowthPolicy();
+    TestShrink();
+    TestMmapAllocator();
+    TestAlignment();
+    TestSearchAndCompareKernels();
+    TestParallelAlgorithms();
+    TestParallelInitialization();
+    TestInstrumentation();
+    TestProfiling();
+    TestCapacityHint();
+    TestSharedSimpleVector();
+    TestConcurrentSimpleVector();
+    TestIncrementalSimpleVector();
+    TestVectorFile();
+    TestSimpleVectorView();
+    TestConstexprSimpleVector();
+    TestSoaSimpleVector();
 }
\ No newline at end of file
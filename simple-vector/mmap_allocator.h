@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Аллокатор для очень больших векторов: каждый буфер — отдельное анонимное отображение mmap.
+// Размер буфера округляется до целого числа страниц, поэтому аллокатор невыгоден для
+// маленьких векторов. Рост буфера тривиально перемещаемых элементов выполняется через
+// mremap(MREMAP_MAYMOVE): ядро переставляет страницы без копирования данных, а при
+// уменьшении буфера освободившиеся страницы сразу возвращаются системе.
+// Если HugePages == true, для буфера запрашиваются прозрачные большие страницы (madvise)
+template <typename Type, bool HugePages = false>
+class MmapAllocator {
+public:
+    using value_type = Type;
+
+    // Гарантированное выравнивание: буфер начинается с границы страницы,
+    // а страница не меньше 4 КиБ
+    static constexpr size_t alignment = 4096;
+
+    template <typename Other>
+    struct rebind {
+        using other = MmapAllocator<Other, HugePages>;
+    };
+
+    MmapAllocator() noexcept = default;
+
+    template <typename Other>
+    MmapAllocator(const MmapAllocator<Other, HugePages>&) noexcept {
+    }
+
+    // Отображает в память страницы для size элементов типа Type.
+    // При неудаче выбрасывает std::bad_alloc, а если размер в байтах не помещается
+    // в size_t — std::bad_array_new_length
+    Type* allocate(size_t size);
+
+    // Возвращает системе страницы буфера buf
+    void deallocate(Type* buf, size_t size) noexcept;
+
+    // Изменяет размер отображения buf с old_size до new_size элементов без копирования данных.
+    // При неудаче выбрасывает std::bad_alloc или std::bad_array_new_length,
+    // оставляя отображение без изменений
+    Type* reallocate(Type* buf, size_t old_size, size_t new_size);
+
+private:
+    static size_t PageSize() noexcept;
+
+    // Выбрасывает std::bad_array_new_length, если размер отображения для size элементов
+    // не помещается в size_t
+    static void CheckSize(size_t size);
+
+    // Возвращает размер в байтах, необходимый для size элементов, округлённый до размера страницы
+    static size_t MappingSize(size_t size) noexcept;
+
+    static void AdviseHugePages(void* buf, size_t bytes) noexcept;
+};
+
+template <typename Type, typename Other, bool HugePages>
+bool operator==(const MmapAllocator<Type, HugePages>&, const MmapAllocator<Other, HugePages>&) noexcept {
+    return true;
+}
+
+template <typename Type, typename Other, bool HugePages>
+bool operator!=(const MmapAllocator<Type, HugePages>&, const MmapAllocator<Other, HugePages>&) noexcept {
+    return false;
+}
+
+// --------------------MmapAllocator--------------------
+
+template <typename Type, bool HugePages>
+Type* MmapAllocator<Type, HugePages>::allocate(size_t size) {
+    CheckSize(size);
+    const size_t bytes = MappingSize(size);
+    void* buf = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buf == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    AdviseHugePages(buf, bytes);
+    return static_cast<Type*>(buf);
+}
+
+template <typename Type, bool HugePages>
+void MmapAllocator<Type, HugePages>::deallocate(Type* buf, size_t size) noexcept {
+    munmap(static_cast<void*>(buf), MappingSize(size));
+}
+
+template <typename Type, bool HugePages>
+Type* MmapAllocator<Type, HugePages>::reallocate(Type* buf, size_t old_size, size_t new_size) {
+    CheckSize(new_size);
+    const size_t old_bytes = MappingSize(old_size);
+    const size_t new_bytes = MappingSize(new_size);
+    if (old_bytes == new_bytes) {
+        return buf;
+    }
+    void* new_buf = mremap(static_cast<void*>(buf), old_bytes, new_bytes, MREMAP_MAYMOVE);
+    if (new_buf == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    if (new_bytes > old_bytes) {
+        AdviseHugePages(new_buf, new_bytes);
+    }
+    return static_cast<Type*>(new_buf);
+}
+
+template <typename Type, bool HugePages>
+size_t MmapAllocator<Type, HugePages>::PageSize() noexcept {
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return page_size;
+}
+
+template <typename Type, bool HugePages>
+void MmapAllocator<Type, HugePages>::CheckSize(size_t size) {
+    if (size > (std::numeric_limits<size_t>::max() - (PageSize() - 1)) / sizeof(Type)) {
+        throw std::bad_array_new_length();
+    }
+}
+
+template <typename Type, bool HugePages>
+size_t MmapAllocator<Type, HugePages>::MappingSize(size_t size) noexcept {
+    const size_t page_size = PageSize();
+    const size_t bytes = size * sizeof(Type);
+    return (bytes + page_size - 1) / page_size * page_size;
+}
+
+template <typename Type, bool HugePages>
+void MmapAllocator<Type, HugePages>::AdviseHugePages([[maybe_unused]] void* buf, [[maybe_unused]] size_t bytes) noexcept {
+#ifdef MADV_HUGEPAGE
+    if constexpr (HugePages) {
+        // Подсказка необязательна: при отключённых THP ядро вернёт ошибку, которую можно игнорировать
+        madvise(buf, bytes, MADV_HUGEPAGE);
+    }
+#endif
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "simple_vector.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// Параллельные алгоритмы над SimpleVector или любым его поддиапазоном [first, last).
+// Диапазон делится на куски по grain_size элементов, которые разбирают рабочие потоки
+// пула и вызывающий поток. Диапазоны короче serial_threshold обрабатываются последовательно.
+// Исключение, выброшенное пользовательской функцией, прерывает раздачу кусков
+// и повторно выбрасывается в вызывающем потоке
+struct ParallelOptions {
+    // Количество элементов в куске, обрабатываемом одной задачей
+    size_t grain_size = 16384;
+
+    // Диапазоны меньшей длины обрабатываются в вызывающем потоке без участия пула
+    size_t serial_threshold = 65536;
+
+    // Пул потоков; nullptr означает ThreadPool::Default()
+    ThreadPool* pool = nullptr;
+
+    // Для ParallelReduce: разбиение на куски и порядок объединения их результатов
+    // не зависят от числа потоков и планирования, поэтому результат неассоциативных
+    // операций (например, сложения чисел с плавающей точкой) воспроизводим, а операция
+    // может быть некоммутативной (конкатенация строк, произведение матриц).
+    // Без этого флага поток сворачивает доставшиеся ему куски в порядке их получения,
+    // поэтому операция должна быть и ассоциативной, и коммутативной
+    bool deterministic = false;
+};
+
+// Вызывает func для каждого элемента [first, last)
+template <typename RandomIt, typename Func>
+void ParallelForEach(RandomIt first, RandomIt last, Func func, const ParallelOptions& options = {});
+
+// Записывает op(x) для каждого элемента x из [first, last) в диапазон, начинающийся с d_first
+template <typename RandomIt, typename OutputIt, typename UnaryOp>
+OutputIt ParallelTransform(RandomIt first, RandomIt last, OutputIt d_first, UnaryOp op,
+                           const ParallelOptions& options = {});
+
+// Сворачивает [first, last) ассоциативной операцией op, начиная с init. Если
+// options.deterministic не задан, op должна быть ещё и коммутативной.
+// Куски сворачиваются начиная со своего первого элемента, а их результаты объединяются
+// той же op, поэтому тип элементов должен совпадать с T. Если op копит результат
+// другого типа (например, сумму квадратов int в long long), нужна перегрузка с combine
+template <typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+T ParallelReduce(RandomIt first, RandomIt last, T init, BinaryOp op = {}, const ParallelOptions& options = {});
+
+// Сворачивает [first, last) операцией op(T, элемент), начиная с init. Каждый кусок
+// сворачивается от T{}, а результаты кусков объединяются ассоциативной операцией
+// combine(T, T), для которой T{} должно быть нейтральным элементом. Если
+// options.deterministic не задан, поток продолжает сворачивать op результат своих
+// прежних кусков, поэтому порядок кусков не сохраняется и combine должна быть
+// коммутативной, а op — допускать любой порядок элементов
+template <typename RandomIt, typename T, typename BinaryOp, typename CombineOp,
+          typename = std::enable_if_t<!std::is_convertible_v<CombineOp, const ParallelOptions&>>>
+T ParallelReduce(RandomIt first, RandomIt last, T init, BinaryOp op, CombineOp combine, const ParallelOptions& options = {});
+
+// Сортирует [first, last): куски сортируются параллельно и затем попарно сливаются
+template <typename RandomIt, typename Compare = std::less<>>
+void ParallelSort(RandomIt first, RandomIt last, Compare comp = {}, const ParallelOptions& options = {});
+
+// Присваивает value каждому элементу [first, last)
+template <typename RandomIt, typename T>
+void ParallelFill(RandomIt first, RandomIt last, const T& value, const ParallelOptions& options = {});
+
+namespace parallel_detail {
+
+// Выполняет func(chunk, slot) для каждого куска из chunk_count, распределяя куски между
+// вызывающим потоком (slot 0) и не более чем slot_count - 1 задачами пула.
+// Возвращает количество задействованных слотов
+template <typename ChunkFunc>
+size_t RunChunks(size_t chunk_count, size_t slot_count, ThreadPool& pool, ChunkFunc func) {
+    if (chunk_count == 0) {
+        return 0;
+    }
+    std::atomic<size_t> next_chunk = 0;
+    std::atomic<size_t> active_helpers = 0;
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto body = [&](size_t slot) {
+        for (size_t chunk; (chunk = next_chunk.fetch_add(1)) < chunk_count;) {
+            try {
+                func(chunk, slot);
+            } catch (...) {
+                std::lock_guard lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next_chunk.store(chunk_count);
+            }
+        }
+    };
+
+    const size_t helpers = std::min(slot_count, chunk_count) - 1;
+    active_helpers.store(helpers);
+    for (size_t slot = 1; slot <= helpers; ++slot) {
+        pool.Submit([&body, &active_helpers, slot] {
+            body(slot);
+            active_helpers.fetch_sub(1);
+        });
+    }
+    body(0);
+    // Пока помощники не завершились, вызывающий поток выполняет задачи пула сам:
+    // так вложенные вызовы из рабочих потоков не ждут друг друга бесконечно
+    while (active_helpers.load() > 0) {
+        if (!pool.RunPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return helpers + 1;
+}
+
+inline ThreadPool& GetPool(const ParallelOptions& options) {
+    return options.pool != nullptr ? *options.pool : ThreadPool::Default();
+}
+
+inline size_t GetChunkCount(size_t size, const ParallelOptions& options) {
+    const size_t grain = std::max(options.grain_size, size_t{1});
+    return (size + grain - 1) / grain;
+}
+
+// Выполняет func(chunk_first, chunk_last) для кусков [0, size) длиной grain_size
+template <typename RangeFunc>
+void ForEachChunk(size_t size, const ParallelOptions& options, RangeFunc func) {
+    if (size < options.serial_threshold) {
+        func(size_t{0}, size);
+        return;
+    }
+    const size_t grain = std::max(options.grain_size, size_t{1});
+    ThreadPool& pool = GetPool(options);
+    RunChunks(GetChunkCount(size, options), pool.GetThreadCount() + 1, pool, [&](size_t chunk, size_t) {
+        const size_t chunk_first = chunk * grain;
+        func(chunk_first, std::min(chunk_first + grain, size));
+    });
+}
+
+// Общая часть ParallelReduce. seed(partial, it) начинает результат куска, при
+// необходимости забирая элементы через it; op добавляет к нему элементы,
+// а combine объединяет результаты кусков с init
+template <typename RandomIt, typename T, typename BinaryOp, typename CombineOp, typename Seed>
+T Reduce(RandomIt first, RandomIt last, T init, BinaryOp& op, CombineOp& combine, const ParallelOptions& options, Seed seed) {
+    const size_t size = static_cast<size_t>(last - first);
+    if (size < options.serial_threshold) {
+        for (; first != last; ++first) {
+            init = op(std::move(init), *first);
+        }
+        return init;
+    }
+    const size_t grain = std::max(options.grain_size, size_t{1});
+    const size_t chunk_count = GetChunkCount(size, options);
+    ThreadPool& pool = GetPool(options);
+
+    // В детерминированном режиме каждый кусок сворачивается отдельно, и результаты
+    // объединяются в порядке кусков. Иначе каждый слот копит общий результат
+    // своих кусков в порядке, в котором их получил, что экономит память и объединения
+    const size_t partial_count = options.deterministic ? chunk_count : pool.GetThreadCount() + 1;
+    SimpleVector<std::optional<T>> partials(partial_count);
+    RunChunks(chunk_count, pool.GetThreadCount() + 1, pool, [&](size_t chunk, size_t slot) {
+        auto it = first + chunk * grain;
+        const auto chunk_last = first + std::min((chunk + 1) * grain, size);
+        std::optional<T>& partial = partials[options.deterministic ? chunk : slot];
+        // Результат слота продолжает копиться op: объединять его с новым куском не нужно
+        if (!partial) {
+            seed(partial, it);
+        }
+        for (; it != chunk_last; ++it) {
+            *partial = op(std::move(*partial), *it);
+        }
+    });
+    for (auto& partial : partials) {
+        if (partial) {
+            init = combine(std::move(init), std::move(*partial));
+        }
+    }
+    return init;
+}
+
+} // namespace parallel_detail
+
+template <typename RandomIt, typename Func>
+void ParallelForEach(RandomIt first, RandomIt last, Func func, const ParallelOptions& options) {
+    parallel_detail::ForEachChunk(static_cast<size_t>(last - first), options, [&](size_t chunk_first, size_t chunk_last) {
+        std::for_each(first + chunk_first, first + chunk_last, func);
+    });
+}
+
+template <typename RandomIt, typename OutputIt, typename UnaryOp>
+OutputIt ParallelTransform(RandomIt first, RandomIt last, OutputIt d_first, UnaryOp op, const ParallelOptions& options) {
+    const size_t size = static_cast<size_t>(last - first);
+    parallel_detail::ForEachChunk(size, options, [&](size_t chunk_first, size_t chunk_last) {
+        std::transform(first + chunk_first, first + chunk_last, d_first + chunk_first, op);
+    });
+    return d_first + size;
+}
+
+template <typename RandomIt, typename T, typename BinaryOp>
+T ParallelReduce(RandomIt first, RandomIt last, T init, BinaryOp op, const ParallelOptions& options) {
+    static_assert(std::is_same_v<typename std::iterator_traits<RandomIt>::value_type, T>,
+                  "ParallelReduce without combine needs T equal to the element type; pass a combine operation");
+    return parallel_detail::Reduce(first, last, std::move(init), op, op, options,
+                                   [](std::optional<T>& partial, RandomIt& it) {
+        partial.emplace(*it++);
+    });
+}
+
+template <typename RandomIt, typename T, typename BinaryOp, typename CombineOp, typename>
+T ParallelReduce(RandomIt first, RandomIt last, T init, BinaryOp op, CombineOp combine, const ParallelOptions& options) {
+    return parallel_detail::Reduce(first, last, std::move(init), op, combine, options,
+                                   [](std::optional<T>& partial, RandomIt&) {
+        partial.emplace();
+    });
+}
+
+template <typename RandomIt, typename Compare>
+void ParallelSort(RandomIt first, RandomIt last, Compare comp, const ParallelOptions& options) {
+    const size_t size = static_cast<size_t>(last - first);
+    if (size < options.serial_threshold) {
+        std::sort(first, last, comp);
+        return;
+    }
+    ThreadPool& pool = parallel_detail::GetPool(options);
+    // Кусков не больше, чем потоков (с запасом для балансировки), и не меньше grain_size элементов
+    const size_t chunk_count = std::min(parallel_detail::GetChunkCount(size, options), (pool.GetThreadCount() + 1) * 2);
+    const size_t chunk_size = (size + chunk_count - 1) / chunk_count;
+    auto bound = [&](size_t chunk) {
+        return first + std::min(chunk * chunk_size, size);
+    };
+    parallel_detail::RunChunks(chunk_count, pool.GetThreadCount() + 1, pool, [&](size_t chunk, size_t) {
+        std::sort(bound(chunk), bound(chunk + 1), comp);
+    });
+    for (size_t width = 1; width < chunk_count; width *= 2) {
+        const size_t merge_count = (chunk_count + 2 * width - 1) / (2 * width);
+        parallel_detail::RunChunks(merge_count, pool.GetThreadCount() + 1, pool, [&](size_t merge, size_t) {
+            const size_t left = merge * 2 * width;
+            const size_t middle = std::min(left + width, chunk_count);
+            const size_t right = std::min(left + 2 * width, chunk_count);
+            std::inplace_merge(bound(left), bound(middle), bound(right), comp);
+        });
+    }
+}
+
+template <typename RandomIt, typename T>
+void ParallelFill(RandomIt first, RandomIt last, const T& value, const ParallelOptions& options) {
+    parallel_detail::ForEachChunk(static_cast<size_t>(last - first), options, [&](size_t chunk_first, size_t chunk_last) {
+        std::fill(first + chunk_first, first + chunk_last, value);
+    });
+}
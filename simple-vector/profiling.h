@@ -0,0 +1,372 @@
+#pragma once
+
+#include "constexpr_support.h"
+
+#include <cstddef>
+
+#ifdef SIMPLE_VECTOR_PROFILING
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+#endif
+
+#if __cplusplus >= 202002L && __has_include(<source_location>)
+#include <source_location>
+#endif
+
+// Профилировщик мест создания векторов. Включается макросом SIMPLE_VECTOR_PROFILING,
+// который должен быть одинаково определён во всех единицах трансляции.
+// Каждый SimpleVector запоминает место своего создания (или последнего явного вызова
+// Reserve) и при разрушении сообщает ему итоговый размер, наибольшую вместимость
+// и число увеличений вместимости. Отчёт ранжирует места по впустую выделенной памяти
+// и подсказывает, где поставить Reserve. Если задана переменная окружения
+// SIMPLE_VECTOR_PROFILE_REPORT, при завершении программы отчёт записывается в указанный
+// файл (или в stderr, если её значение "-").
+// Без макроса профиль вектора — пустой базовый класс, и размер SimpleVector не меняется,
+// а накопитель профиля и функции отчёта не объявляются
+#ifdef SIMPLE_VECTOR_PROFILING
+inline constexpr bool PROFILING_ENABLED = true;
+#else
+inline constexpr bool PROFILING_ENABLED = false;
+#endif
+
+// Место в исходном коде. Аналог std::source_location, доступный в C++17
+struct SourceLocation {
+    const char* file = nullptr;
+    const char* function = nullptr;
+    unsigned line = 0;
+
+#if __cplusplus >= 202002L && __has_include(<source_location>)
+    static constexpr SourceLocation Current(std::source_location location = std::source_location::current()) noexcept {
+        return {location.file_name(), location.function_name(), location.line()};
+    }
+#elif defined(__GNUC__) || defined(__clang__)
+    static constexpr SourceLocation Current(const char* file = __builtin_FILE(), const char* function = __builtin_FUNCTION(),
+                                            unsigned line = __builtin_LINE()) noexcept {
+        return {file, function, line};
+    }
+#else
+    static constexpr SourceLocation Current() noexcept {
+        return {};
+    }
+#endif
+
+    // Сообщает, известно ли место. Векторы без места не попадают в профиль
+    constexpr explicit operator bool() const noexcept {
+        return file != nullptr;
+    }
+};
+
+// Место создания, принимаемое конструктором SimpleVector по умолчанию. Отдельный тип
+// не даёт SourceLocation неявно преобразовываться в SimpleVector: для этого потребовалось
+// бы два пользовательских преобразования подряд
+struct CreationSite {
+    SourceLocation location;
+
+    constexpr CreationSite(SourceLocation location) noexcept
+        : location(location) {
+    }
+};
+
+namespace profiling {
+
+// Профиль одного вектора: место создания, наибольшая вместимость и число её увеличений.
+// SimpleVector наследует его закрыто; при выключенном профилировании класс пуст
+template <bool Enabled = PROFILING_ENABLED>
+class VectorProfile;
+
+} // namespace profiling
+
+#ifdef SIMPLE_VECTOR_PROFILING
+
+// Сводка по одному месту создания векторов
+struct SiteProfile {
+    SourceLocation location;
+    size_t element_size = 0;
+
+    // Количество разрушенных векторов этого места
+    size_t vectors = 0;
+
+    // Суммарный и наибольший итоговый размер (размер перед разрушением)
+    size_t total_final_size = 0;
+    size_t max_final_size = 0;
+
+    // Суммарная и наибольшая вместимость, достигнутая векторами
+    size_t total_peak_capacity = 0;
+    size_t max_peak_capacity = 0;
+
+    // Суммарное и наибольшее на один вектор число увеличений вместимости
+    size_t total_growths = 0;
+    size_t max_growths = 0;
+
+    // Память, выделенная сверх итогового размера: (наибольшая вместимость - размер) * element_size
+    size_t wasted_bytes = 0;
+
+    // Возвращает долю использованной вместимости от 0 до 1
+    double GetUtilization() const noexcept {
+        return total_peak_capacity == 0 ? 1.0 : static_cast<double>(total_final_size) / total_peak_capacity;
+    }
+};
+
+// Возвращает профили мест, упорядоченные по убыванию wasted_bytes, затем total_growths
+std::vector<SiteProfile> GetVectorProfile();
+
+// Записывает в out таблицу не более чем max_sites мест с наибольшими потерями
+void WriteVectorProfileReport(std::ostream& out, size_t max_sites = 20);
+
+// Очищает накопленный профиль
+void ResetVectorProfile();
+
+namespace profiling {
+
+// Накопитель профилей мест. Создаётся при первом обращении и намеренно не разрушается,
+// чтобы статические векторы могли сообщать о себе при завершении программы
+class Registry {
+public:
+    static Registry& Instance();
+
+    void Record(SourceLocation location, size_t element_size, size_t final_size, size_t peak_capacity, size_t growths);
+
+    std::vector<SiteProfile> Snapshot() const;
+
+    void Reset();
+
+private:
+    using Key = std::tuple<std::string_view, unsigned, std::string_view, size_t>;
+
+    mutable std::mutex mutex_;
+    std::map<Key, SiteProfile> sites_;
+
+    Registry() = default;
+
+    static void ReportAtExit();
+};
+
+template <bool Enabled>
+class VectorProfile {
+public:
+    SIMPLE_VECTOR_CONSTEXPR explicit VectorProfile(SourceLocation location) noexcept;
+
+    // Копия вектора относится к тому же месту, но ведёт собственную статистику
+    SIMPLE_VECTOR_CONSTEXPR VectorProfile(const VectorProfile& other) noexcept;
+
+    // Статистика переходит к новому вектору, исходный больше не учитывается
+    SIMPLE_VECTOR_CONSTEXPR VectorProfile(VectorProfile&& other) noexcept;
+
+    VectorProfile& operator=(const VectorProfile&) = delete;
+
+    SIMPLE_VECTOR_CONSTEXPR SourceLocation GetLocation() const noexcept;
+
+    // Вектор перешёл к буферу вместимостью new_capacity вместо old_capacity
+    SIMPLE_VECTOR_CONSTEXPR void OnCapacityChange(size_t old_capacity, size_t new_capacity) noexcept;
+
+    // Явный вызов Reserve: вектор переходит к месту location
+    SIMPLE_VECTOR_CONSTEXPR void OnReserve(SourceLocation location) noexcept;
+
+    // Вектор с элементами размера element_size разрушается, имея size элементов
+    SIMPLE_VECTOR_CONSTEXPR void OnDestroy(size_t size, size_t element_size) noexcept;
+
+    SIMPLE_VECTOR_CONSTEXPR void Swap(VectorProfile& other) noexcept;
+
+private:
+    SourceLocation location_;
+    size_t peak_capacity_ = 0;
+    size_t growths_ = 0;
+};
+
+} // namespace profiling
+
+#endif // SIMPLE_VECTOR_PROFILING
+
+namespace profiling {
+
+template <>
+class VectorProfile<false> {
+public:
+    SIMPLE_VECTOR_CONSTEXPR explicit VectorProfile(SourceLocation) noexcept {
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR SourceLocation GetLocation() const noexcept {
+        return {};
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void OnCapacityChange(size_t, size_t) noexcept {
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void OnReserve(SourceLocation) noexcept {
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void OnDestroy(size_t, size_t) noexcept {
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Swap(VectorProfile&) noexcept {
+    }
+};
+
+} // namespace profiling
+
+#ifdef SIMPLE_VECTOR_PROFILING
+
+// ---------------profiling::Registry---------------
+
+namespace profiling {
+
+inline Registry& Registry::Instance() {
+    static Registry* registry = [] {
+        std::atexit(&Registry::ReportAtExit);
+        return new Registry();
+    }();
+    return *registry;
+}
+
+inline void Registry::Record(SourceLocation location, size_t element_size, size_t final_size, size_t peak_capacity, size_t growths) {
+    std::lock_guard lock(mutex_);
+    SiteProfile& site = sites_[Key(location.file, location.line, location.function, element_size)];
+    site.location = location;
+    site.element_size = element_size;
+    ++site.vectors;
+    site.total_final_size += final_size;
+    site.max_final_size = std::max(site.max_final_size, final_size);
+    site.total_peak_capacity += peak_capacity;
+    site.max_peak_capacity = std::max(site.max_peak_capacity, peak_capacity);
+    site.total_growths += growths;
+    site.max_growths = std::max(site.max_growths, growths);
+    site.wasted_bytes += (std::max(peak_capacity, final_size) - final_size) * element_size;
+}
+
+inline std::vector<SiteProfile> Registry::Snapshot() const {
+    std::vector<SiteProfile> result;
+    {
+        std::lock_guard lock(mutex_);
+        result.reserve(sites_.size());
+        for (const auto& [key, site] : sites_) {
+            result.push_back(site);
+        }
+    }
+    std::stable_sort(result.begin(), result.end(), [](const SiteProfile& lhs, const SiteProfile& rhs) {
+        return std::tie(rhs.wasted_bytes, rhs.total_growths) < std::tie(lhs.wasted_bytes, lhs.total_growths);
+    });
+    return result;
+}
+
+inline void Registry::Reset() {
+    std::lock_guard lock(mutex_);
+    sites_.clear();
+}
+
+inline void Registry::ReportAtExit() {
+    const char* path = std::getenv("SIMPLE_VECTOR_PROFILE_REPORT");
+    if (path == nullptr || *path == '\0') {
+        return;
+    }
+    if (std::string_view(path) == "-") {
+        WriteVectorProfileReport(std::cerr);
+        return;
+    }
+    std::ofstream out(path);
+    WriteVectorProfileReport(out);
+}
+
+} // namespace profiling
+
+inline std::vector<SiteProfile> GetVectorProfile() {
+    return profiling::Registry::Instance().Snapshot();
+}
+
+inline void WriteVectorProfileReport(std::ostream& out, size_t max_sites) {
+    const std::vector<SiteProfile> sites = GetVectorProfile();
+    out << "SimpleVector profile: " << sites.size() << " sites\n";
+    const size_t count = std::min(max_sites, sites.size());
+    for (size_t i = 0; i < count; ++i) {
+        const SiteProfile& site = sites[i];
+        char utilization[16];
+        std::snprintf(utilization, sizeof(utilization), "%.1f%%", site.GetUtilization() * 100.0);
+        out << '#' << i + 1 << ' ' << site.location.file << ':' << site.location.line << " (" << site.location.function
+            << ")\n    vectors: " << site.vectors << ", element size: " << site.element_size
+            << ", wasted bytes: " << site.wasted_bytes << ", utilization: " << utilization
+            << "\n    final size avg/max: " << site.total_final_size / site.vectors << '/' << site.max_final_size
+            << ", peak capacity max: " << site.max_peak_capacity
+            << ", growths avg/max: " << site.total_growths / site.vectors << '/' << site.max_growths << '\n';
+        if (site.max_growths > 1) {
+            out << "    hint: Reserve(" << site.max_final_size << ")\n";
+        }
+    }
+}
+
+inline void ResetVectorProfile() {
+    profiling::Registry::Instance().Reset();
+}
+
+// ---------------profiling::VectorProfile---------------
+
+namespace profiling {
+
+template <bool Enabled>
+SIMPLE_VECTOR_CONSTEXPR VectorProfile<Enabled>::VectorProfile(SourceLocation location) noexcept
+    : location_(location) {
+}
+
+template <bool Enabled>
+SIMPLE_VECTOR_CONSTEXPR VectorProfile<Enabled>::VectorProfile(const VectorProfile& other) noexcept
+    : location_(other.location_) {
+}
+
+template <bool Enabled>
+SIMPLE_VECTOR_CONSTEXPR VectorProfile<Enabled>::VectorProfile(VectorProfile&& other) noexcept
+    : location_(std::exchange(other.location_, SourceLocation{}))
+    , peak_capacity_(std::exchange(other.peak_capacity_, 0))
+    , growths_(std::exchange(other.growths_, 0)) {
+}
+
+template <bool Enabled>
+SIMPLE_VECTOR_CONSTEXPR SourceLocation VectorProfile<Enabled>::GetLocation() const noexcept {
+    return location_;
+}
+
+template <bool Enabled>
+SIMPLE_VECTOR_CONSTEXPR void VectorProfile<Enabled>::OnCapacityChange(size_t old_capacity, size_t new_capacity) noexcept {
+    if (new_capacity > old_capacity) {
+        ++growths_;
+        peak_capacity_ = std::max(peak_capacity_, new_capacity);
+    }
+}
+
+template <bool Enabled>
+SIMPLE_VECTOR_CONSTEXPR void VectorProfile<Enabled>::OnReserve(SourceLocation location) noexcept {
+    if (location) {
+        location_ = location;
+    }
+}
+
+template <bool Enabled>
+SIMPLE_VECTOR_CONSTEXPR void VectorProfile<Enabled>::OnDestroy(size_t size, size_t element_size) noexcept {
+    // Векторы, вычисляемые в константных выражениях, в профиль не попадают
+    if (!location_ || IsConstantEvaluated()) {
+        return;
+    }
+    try {
+        Registry::Instance().Record(location_, element_size, size, peak_capacity_, growths_);
+    } catch (...) {
+        // Профиль не должен влиять на работу программы: запись теряется
+    }
+}
+
+template <bool Enabled>
+SIMPLE_VECTOR_CONSTEXPR void VectorProfile<Enabled>::Swap(VectorProfile& other) noexcept {
+    std::swap(location_, other.location_);
+    std::swap(peak_capacity_, other.peak_capacity_);
+    std::swap(growths_, other.growths_);
+}
+
+} // namespace profiling
+
+#endif // SIMPLE_VECTOR_PROFILING
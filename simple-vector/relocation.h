@@ -0,0 +1,76 @@
+#pragma once
+
+#include "constexpr_support.h"
+
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+// Признак тривиальной перемещаемости: объект типа Type можно перенести в другую
+// область памяти побайтовым копированием, не вызывая конструктор перемещения
+// и деструктор исходного объекта.
+// По умолчанию выполняется для тривиально копируемых типов. Для собственных типов,
+// не хранящих указателей на самих себя, признак можно включить специализацией:
+//
+//     template <>
+//     struct IsTriviallyRelocatable<MyType> : std::true_type {};
+template <typename Type>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<Type> {};
+
+template <typename Type>
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<Type>::value;
+
+// Переносит count объектов из from в неинициализированную память to.
+// Области памяти не должны перекрываться. В константном выражении байты копировать
+// нельзя, поэтому объекты переносятся конструктором перемещения и разрушаются
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void RelocateBytes(Type* from, size_t count, Type* to) noexcept {
+    if (IsConstantEvaluated()) {
+        for (size_t i = 0; i < count; ++i) {
+            ConstructAt(to + i, std::move(from[i]));
+            std::destroy_at(from + i);
+        }
+        return;
+    }
+    if (count > 0) {
+        std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(Type));
+    }
+}
+
+// Переносит count объектов из from в to. Области памяти могут перекрываться
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void ShiftBytes(Type* from, size_t count, Type* to) noexcept {
+    if (IsConstantEvaluated()) {
+        // Каждый объект переносится на место, уже освобождённое предыдущим шагом
+        if (to < from) {
+            RelocateBytes(from, count, to);
+        }
+        else {
+            for (size_t i = count; i > 0; --i) {
+                ConstructAt(to + i - 1, std::move(from[i - 1]));
+                std::destroy_at(from + i - 1);
+            }
+        }
+        return;
+    }
+    if (count > 0) {
+        std::memmove(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(Type));
+    }
+}
+
+// Переносит count объектов из from в неинициализированную память to.
+// Тривиально перемещаемые объекты переносятся побайтово, остальные
+// перемещаются, если это безопасно, иначе копируются. Исходные объекты,
+// кроме тривиально перемещаемых, остаются живыми и должны быть разрушены вызывающим
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedRelocate(Type* from, size_t count, Type* to) {
+    if constexpr (IsTriviallyRelocatableV<Type>) {
+        RelocateBytes(from, count, to);
+    }
+    else if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+        UninitializedMoveN(from, count, to);
+    }
+    else {
+        UninitializedCopyN(from, count, to);
+    }
+}
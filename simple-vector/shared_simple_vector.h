@@ -0,0 +1,436 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <initializer_list>
+#include <utility>
+
+// Вектор с разделяемым буфером и копированием при записи. Копия SharedSimpleVector
+// занимает O(1): копии ссылаются на один буфер со счётчиком ссылок, а элементы
+// копируются только при первом изменяющем вызове (PushBack, Insert, Erase, неконстантные
+// operator[], At, begin и т.п.) у вектора, буфер которого разделён с другими.
+// Разные объекты SharedSimpleVector, ссылающиеся на один буфер, можно читать и копировать
+// из разных потоков одновременно; один и тот же объект, как и SimpleVector, требует
+// внешней синхронизации, если его изменяют.
+// Итераторы и ссылки, полученные до изменяющего вызова, становятся недействительными.
+// Изменяемые ссылки и итераторы нельзя использовать после копирования вектора:
+// копия разделит с ним буфер, и запись через них станет видна обоим
+template <typename Type>
+class SharedSimpleVector {
+public:
+    using VectorType = SimpleVector<Type>;
+    using Iterator = typename VectorType::Iterator;
+    using ConstIterator = typename VectorType::ConstIterator;
+
+    SharedSimpleVector() noexcept = default;
+    explicit SharedSimpleVector(size_t size);
+    SharedSimpleVector(size_t size, const Type& value);
+    SharedSimpleVector(std::initializer_list<Type> init);
+
+    // Забирает элементы vector без копирования
+    SharedSimpleVector(VectorType&& vector);
+
+    // Копирует элементы vector в новый буфер
+    explicit SharedSimpleVector(const VectorType& vector);
+
+    // Разделяет буфер other
+    SharedSimpleVector(const SharedSimpleVector& other) noexcept;
+    SharedSimpleVector(SharedSimpleVector&& other) noexcept;
+
+    SharedSimpleVector& operator=(const SharedSimpleVector& rhs) noexcept;
+    SharedSimpleVector& operator=(SharedSimpleVector&& rhs) noexcept;
+
+    ~SharedSimpleVector();
+
+    // Возвращает вектор с элементами: без копирования, если буфер ни с кем не разделён.
+    // После вызова этот объект пуст
+    VectorType ToSimpleVector() &&;
+
+    // Возвращает копию элементов
+    VectorType ToSimpleVector() const&;
+
+    // Возвращает константную ссылку на вектор с элементами
+    const VectorType& GetVector() const noexcept;
+
+    // Возвращает количество объектов SharedSimpleVector, разделяющих буфер, либо 0 для пустого
+    size_t GetUseCount() const noexcept;
+
+    // Сообщает, что буфер ни с кем не разделён и изменения не потребуют копирования
+    bool IsUnique() const noexcept;
+
+    size_t GetSize() const noexcept;
+    size_t GetCapacity() const noexcept;
+    bool IsEmpty() const noexcept;
+
+    const Type& operator[](size_t index) const noexcept;
+    const Type& At(size_t index) const;
+
+    ConstIterator begin() const noexcept;
+    ConstIterator end() const noexcept;
+    ConstIterator cbegin() const noexcept;
+    ConstIterator cend() const noexcept;
+
+    // Изменяющие методы. Если буфер разделён, элементы сначала копируются в собственный буфер.
+    // Семантика совпадает с одноимёнными методами SimpleVector
+    Type& operator[](size_t index);
+    Type& At(size_t index);
+    Iterator begin();
+    Iterator end();
+
+    void PushBack(const Type& item);
+    void PushBack(Type&& item);
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args);
+
+    void PopBack();
+    Iterator Insert(ConstIterator pos, const Type& value);
+    Iterator Insert(ConstIterator pos, Type&& value);
+    Iterator Erase(ConstIterator pos);
+    Iterator Erase(ConstIterator first, ConstIterator last);
+    void Reserve(size_t new_capacity);
+    void Resize(size_t new_size);
+
+    // Отказывается от буфера: вектор становится пустым, не копируя элементы
+    void Clear() noexcept;
+
+    void Swap(SharedSimpleVector& other) noexcept;
+
+private:
+    struct Buffer {
+        std::atomic<size_t> refs = 1;
+        VectorType vector;
+    };
+
+    Buffer* buffer_ = nullptr;
+
+    explicit SharedSimpleVector(Buffer* buffer) noexcept;
+
+    // Делает буфер собственным, копируя элементы, если он разделён. Возвращает его вектор
+    VectorType& Detach();
+
+    // Возвращает индекс pos в текущем буфере
+    size_t IndexOf(ConstIterator pos) const noexcept;
+
+    static void Release(Buffer* buffer) noexcept;
+};
+
+template <typename Type>
+bool operator==(const SharedSimpleVector<Type>& lhs, const SharedSimpleVector<Type>& rhs) {
+    return lhs.GetVector() == rhs.GetVector();
+}
+
+template <typename Type>
+bool operator!=(const SharedSimpleVector<Type>& lhs, const SharedSimpleVector<Type>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type>
+bool operator<(const SharedSimpleVector<Type>& lhs, const SharedSimpleVector<Type>& rhs) {
+    return lhs.GetVector() < rhs.GetVector();
+}
+
+template <typename Type>
+bool operator<=(const SharedSimpleVector<Type>& lhs, const SharedSimpleVector<Type>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type>
+bool operator>(const SharedSimpleVector<Type>& lhs, const SharedSimpleVector<Type>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type>
+bool operator>=(const SharedSimpleVector<Type>& lhs, const SharedSimpleVector<Type>& rhs) {
+    return !(lhs < rhs);
+}
+
+// ----------------SharedSimpleVector----------------
+
+template <typename Type>
+SharedSimpleVector<Type>::SharedSimpleVector(size_t size)
+    : SharedSimpleVector(VectorType(size)) {
+}
+
+template <typename Type>
+SharedSimpleVector<Type>::SharedSimpleVector(size_t size, const Type& value)
+    : SharedSimpleVector(VectorType(size, value)) {
+}
+
+template <typename Type>
+SharedSimpleVector<Type>::SharedSimpleVector(std::initializer_list<Type> init)
+    : SharedSimpleVector(VectorType(init)) {
+}
+
+template <typename Type>
+SharedSimpleVector<Type>::SharedSimpleVector(VectorType&& vector)
+    : buffer_(new Buffer{1, std::move(vector)}) {
+}
+
+template <typename Type>
+SharedSimpleVector<Type>::SharedSimpleVector(const VectorType& vector)
+    : buffer_(new Buffer{1, vector}) {
+}
+
+template <typename Type>
+SharedSimpleVector<Type>::SharedSimpleVector(const SharedSimpleVector& other) noexcept
+    : buffer_(other.buffer_) {
+    if (buffer_ != nullptr) {
+        buffer_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename Type>
+SharedSimpleVector<Type>::SharedSimpleVector(SharedSimpleVector&& other) noexcept
+    : buffer_(std::exchange(other.buffer_, nullptr)) {
+}
+
+template <typename Type>
+SharedSimpleVector<Type>::SharedSimpleVector(Buffer* buffer) noexcept
+    : buffer_(buffer) {
+}
+
+template <typename Type>
+SharedSimpleVector<Type>& SharedSimpleVector<Type>::operator=(const SharedSimpleVector& rhs) noexcept {
+    SharedSimpleVector temp(rhs);
+    Swap(temp);
+    return *this;
+}
+
+template <typename Type>
+SharedSimpleVector<Type>& SharedSimpleVector<Type>::operator=(SharedSimpleVector&& rhs) noexcept {
+    SharedSimpleVector temp(std::move(rhs));
+    Swap(temp);
+    return *this;
+}
+
+template <typename Type>
+SharedSimpleVector<Type>::~SharedSimpleVector() {
+    Release(buffer_);
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::VectorType SharedSimpleVector<Type>::ToSimpleVector() && {
+    if (buffer_ == nullptr) {
+        return VectorType();
+    }
+    SharedSimpleVector temp(std::move(*this));
+    if (temp.IsUnique()) {
+        return std::move(temp.buffer_->vector);
+    }
+    return temp.buffer_->vector;
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::VectorType SharedSimpleVector<Type>::ToSimpleVector() const& {
+    return GetVector();
+}
+
+template <typename Type>
+const typename SharedSimpleVector<Type>::VectorType& SharedSimpleVector<Type>::GetVector() const noexcept {
+    static const VectorType empty;
+    return buffer_ != nullptr ? buffer_->vector : empty;
+}
+
+template <typename Type>
+size_t SharedSimpleVector<Type>::GetUseCount() const noexcept {
+    return buffer_ != nullptr ? buffer_->refs.load(std::memory_order_acquire) : 0;
+}
+
+template <typename Type>
+bool SharedSimpleVector<Type>::IsUnique() const noexcept {
+    return GetUseCount() == 1;
+}
+
+template <typename Type>
+size_t SharedSimpleVector<Type>::GetSize() const noexcept {
+    return GetVector().GetSize();
+}
+
+template <typename Type>
+size_t SharedSimpleVector<Type>::GetCapacity() const noexcept {
+    return GetVector().GetCapacity();
+}
+
+template <typename Type>
+bool SharedSimpleVector<Type>::IsEmpty() const noexcept {
+    return GetVector().IsEmpty();
+}
+
+template <typename Type>
+const Type& SharedSimpleVector<Type>::operator[](size_t index) const noexcept {
+    return GetVector()[index];
+}
+
+template <typename Type>
+const Type& SharedSimpleVector<Type>::At(size_t index) const {
+    return GetVector().At(index);
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::ConstIterator SharedSimpleVector<Type>::begin() const noexcept {
+    return GetVector().begin();
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::ConstIterator SharedSimpleVector<Type>::end() const noexcept {
+    return GetVector().end();
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::ConstIterator SharedSimpleVector<Type>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::ConstIterator SharedSimpleVector<Type>::cend() const noexcept {
+    return end();
+}
+
+template <typename Type>
+Type& SharedSimpleVector<Type>::operator[](size_t index) {
+    return Detach()[index];
+}
+
+template <typename Type>
+Type& SharedSimpleVector<Type>::At(size_t index) {
+    if (!(index < GetSize()))
+        throw std::out_of_range("The index value is out of range");
+    return Detach()[index];
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::Iterator SharedSimpleVector<Type>::begin() {
+    return Detach().begin();
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::Iterator SharedSimpleVector<Type>::end() {
+    return Detach().end();
+}
+
+template <typename Type>
+void SharedSimpleVector<Type>::PushBack(const Type& item) {
+    EmplaceBack(item);
+}
+
+template <typename Type>
+void SharedSimpleVector<Type>::PushBack(Type&& item) {
+    EmplaceBack(std::move(item));
+}
+
+template <typename Type>
+template <typename... Args>
+Type& SharedSimpleVector<Type>::EmplaceBack(Args&&... args) {
+    if (IsUnique()) {
+        return buffer_->vector.EmplaceBack(std::forward<Args>(args)...);
+    }
+    // Элемент создаётся до копирования, так как args могут ссылаться на разделяемый буфер
+    Type item(std::forward<Args>(args)...);
+    return Detach().EmplaceBack(std::move(item));
+}
+
+template <typename Type>
+void SharedSimpleVector<Type>::PopBack() {
+    assert(!IsEmpty());
+    if (IsUnique()) {
+        buffer_->vector.PopBack();
+        return;
+    }
+    // Из разделённого буфера копируются только остающиеся элементы
+    const VectorType& vector = buffer_->vector;
+    SharedSimpleVector copy(new Buffer{1, VectorType(::Reserve(vector.GetSize() - 1))});
+    copy.buffer_->vector.Append(vector.begin(), vector.end() - 1);
+    Swap(copy);
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::Iterator SharedSimpleVector<Type>::Insert(ConstIterator pos, const Type& value) {
+    const size_t index = IndexOf(pos);
+    if (IsUnique()) {
+        return buffer_->vector.Insert(buffer_->vector.cbegin() + index, value);
+    }
+    Type item(value);
+    VectorType& vector = Detach();
+    return vector.Insert(vector.cbegin() + index, std::move(item));
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::Iterator SharedSimpleVector<Type>::Insert(ConstIterator pos, Type&& value) {
+    const size_t index = IndexOf(pos);
+    VectorType& vector = Detach();
+    return vector.Insert(vector.cbegin() + index, std::move(value));
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::Iterator SharedSimpleVector<Type>::Erase(ConstIterator pos) {
+    return Erase(pos, pos + 1);
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::Iterator SharedSimpleVector<Type>::Erase(ConstIterator first, ConstIterator last) {
+    const size_t index = IndexOf(first);
+    const size_t count = last - first;
+    if (buffer_ == nullptr || IsUnique()) {
+        VectorType& vector = Detach();
+        return vector.Erase(vector.cbegin() + index, vector.cbegin() + index + count);
+    }
+    // Из разделённого буфера копируются только остающиеся элементы
+    const VectorType& vector = buffer_->vector;
+    SharedSimpleVector copy(new Buffer{1, VectorType(::Reserve(vector.GetSize() - count))});
+    copy.buffer_->vector.Append(vector.begin(), vector.begin() + index);
+    copy.buffer_->vector.Append(vector.begin() + index + count, vector.end());
+    Swap(copy);
+    return buffer_->vector.begin() + index;
+}
+
+template <typename Type>
+void SharedSimpleVector<Type>::Reserve(size_t new_capacity) {
+    if (new_capacity > GetCapacity()) {
+        Detach().Reserve(new_capacity);
+    }
+}
+
+template <typename Type>
+void SharedSimpleVector<Type>::Resize(size_t new_size) {
+    if (new_size != GetSize()) {
+        Detach().Resize(new_size);
+    }
+}
+
+template <typename Type>
+void SharedSimpleVector<Type>::Clear() noexcept {
+    Release(std::exchange(buffer_, nullptr));
+}
+
+template <typename Type>
+void SharedSimpleVector<Type>::Swap(SharedSimpleVector& other) noexcept {
+    std::swap(buffer_, other.buffer_);
+}
+
+template <typename Type>
+typename SharedSimpleVector<Type>::VectorType& SharedSimpleVector<Type>::Detach() {
+    if (buffer_ == nullptr) {
+        buffer_ = new Buffer();
+    }
+    else if (!IsUnique()) {
+        SharedSimpleVector copy(new Buffer{1, buffer_->vector});
+        Swap(copy);
+    }
+    return buffer_->vector;
+}
+
+template <typename Type>
+size_t SharedSimpleVector<Type>::IndexOf(ConstIterator pos) const noexcept {
+    assert(cbegin() <= pos && pos <= cend());
+    return static_cast<size_t>(pos - cbegin());
+}
+
+template <typename Type>
+void SharedSimpleVector<Type>::Release(Buffer* buffer) noexcept {
+    if (buffer != nullptr && buffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete buffer;
+    }
+}
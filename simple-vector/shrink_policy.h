@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+// Политики автоматического освобождения вместимости SimpleVector.
+// Политика предоставляет статический метод ShrinkCapacity(size, capacity), возвращающий
+// вместимость, до которой следует уменьшить буфер вектора с size элементами, либо
+// capacity, если память возвращать не нужно. Политика применяется после PopBack,
+// Erase, Clear и уменьшающего Resize. Метод, объявленный constexpr, позволяет вычислять
+// вектор в константных выражениях
+
+// Никогда не освобождает память автоматически. Вместимость уменьшает только ShrinkToFit
+struct NeverShrink {
+    static constexpr size_t ShrinkCapacity(size_t size, size_t capacity) noexcept;
+};
+
+// Уменьшает буфер, когда размер падает до 1/ShrinkDivisor вместимости, оставляя
+// вдвое больше места, чем занято. Между порогом освобождения и порогом роста остаётся
+// зазор (гистерезис), поэтому чередование вставок и удалений около порога не вызывает
+// перевыделений на каждой операции. Буферы не больше MinCapacity элементов не уменьшаются
+template <size_t ShrinkDivisor = 4, size_t MinCapacity = 16>
+struct HysteresisShrink {
+    static_assert(ShrinkDivisor > 2, "Shrink threshold must stay below the post-shrink utilization of 1/2");
+
+    static constexpr size_t ShrinkCapacity(size_t size, size_t capacity) noexcept;
+};
+
+// ---------------------NeverShrink---------------------
+
+constexpr size_t NeverShrink::ShrinkCapacity(size_t, size_t capacity) noexcept {
+    return capacity;
+}
+
+// -------------------HysteresisShrink------------------
+
+template <size_t ShrinkDivisor, size_t MinCapacity>
+constexpr size_t HysteresisShrink<ShrinkDivisor, MinCapacity>::ShrinkCapacity(size_t size, size_t capacity) noexcept {
+    if (capacity <= MinCapacity || size > capacity / ShrinkDivisor) {
+        return capacity;
+    }
+    return std::max(size * 2, MinCapacity);
+}
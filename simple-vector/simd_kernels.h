@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Векторизованные ядра сравнения и поиска для арифметических типов элементов.
+// Каждое ядро компилируется в нескольких вариантах (AVX-512, AVX2 и базовый SSE2 для x86-64),
+// нужный выбирается один раз при загрузке программы по возможностям процессора.
+// На прочих платформах и компиляторах ядра собираются как обычные скалярные циклы.
+// Функции верхнего уровня (Find, Count, Equal, Less, MinElement, MaxElement, Hash)
+// сами выбирают ядро для подходящих типов и алгоритм STL для остальных.
+// Под ThreadSanitizer варианты не создаются: их ifunc-резолверы вызываются до его инициализации
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && !defined(__SANITIZE_THREAD__)
+#define SIMPLE_VECTOR_SIMD_CLONES __attribute__((target_clones("arch=x86-64-v4", "arch=x86-64-v3", "default")))
+#else
+#define SIMPLE_VECTOR_SIMD_CLONES
+#endif
+
+namespace simd {
+
+// Признак типа, для которого используются векторизованные ядра поиска и сравнения на равенство
+template <typename Type>
+inline constexpr bool IsVectorizableV = std::is_arithmetic_v<Type>;
+
+// Признак типа, для которого векторизуются лексикографическое сравнение, поиск минимума
+// и максимума и побайтовое хеширование. Плавающая точка исключена из-за NaN и -0.0
+template <typename Type>
+inline constexpr bool IsVectorizableOrderedV = std::is_integral_v<Type>;
+
+// Признаки того, что сравнение элементов на равенство, сравнение на меньше и хеширование
+// не выбрасывают исключений. Для арифметических типов выполняются всегда
+template <typename Type>
+inline constexpr bool IsNothrowEqualV = IsVectorizableV<Type>
+    || noexcept(static_cast<bool>(std::declval<const Type&>() == std::declval<const Type&>()));
+
+template <typename Type>
+inline constexpr bool IsNothrowLessV = IsVectorizableV<Type>
+    || noexcept(static_cast<bool>(std::declval<const Type&>() < std::declval<const Type&>()));
+
+template <typename Type>
+inline constexpr bool IsNothrowHashV = IsVectorizableOrderedV<Type>
+    || noexcept(std::hash<Type>()(std::declval<const Type&>()));
+
+// Число элементов в блоке, проверяемом ядрами поиска без ветвлений: 64 байта, одна кэш-линия
+template <typename Type>
+inline constexpr size_t BLOCK_SIZE = 64 / sizeof(Type) > 0 ? 64 / sizeof(Type) : 1;
+
+// Возвращает индекс первого элемента, равного value, либо size
+template <typename Type>
+SIMPLE_VECTOR_SIMD_CLONES size_t FindIndex(const Type* data, size_t size, Type value) noexcept {
+    constexpr size_t block = BLOCK_SIZE<Type>;
+    size_t i = 0;
+    for (; i + block <= size; i += block) {
+        unsigned found = 0;
+        for (size_t j = 0; j < block; ++j) {
+            found |= data[i + j] == value;
+        }
+        if (found != 0) {
+            break;
+        }
+    }
+    for (; i < size; ++i) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return size;
+}
+
+// Возвращает количество элементов, равных value
+template <typename Type>
+SIMPLE_VECTOR_SIMD_CLONES size_t CountEqual(const Type* data, size_t size, Type value) noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        count += data[i] == value;
+    }
+    return count;
+}
+
+// Возвращает индекс первой позиции, в которой lhs и rhs различаются, либо size
+template <typename Type>
+SIMPLE_VECTOR_SIMD_CLONES size_t MismatchIndex(const Type* lhs, const Type* rhs, size_t size) noexcept {
+    constexpr size_t block = BLOCK_SIZE<Type>;
+    size_t i = 0;
+    for (; i + block <= size; i += block) {
+        unsigned differs = 0;
+        for (size_t j = 0; j < block; ++j) {
+            differs |= lhs[i + j] != rhs[i + j];
+        }
+        if (differs != 0) {
+            break;
+        }
+    }
+    for (; i < size; ++i) {
+        if (lhs[i] != rhs[i]) {
+            return i;
+        }
+    }
+    return size;
+}
+
+// Возвращает наименьшее значение непустого массива
+template <typename Type>
+SIMPLE_VECTOR_SIMD_CLONES Type MinValue(const Type* data, size_t size) noexcept {
+    Type result = data[0];
+    for (size_t i = 1; i < size; ++i) {
+        result = data[i] < result ? data[i] : result;
+    }
+    return result;
+}
+
+// Возвращает наибольшее значение непустого массива
+template <typename Type>
+SIMPLE_VECTOR_SIMD_CLONES Type MaxValue(const Type* data, size_t size) noexcept {
+    Type result = data[0];
+    for (size_t i = 1; i < size; ++i) {
+        result = result < data[i] ? data[i] : result;
+    }
+    return result;
+}
+
+// Хеширует size байт data. Шестнадцать независимых 32-битных полос обрабатывают
+// по 64 байта за итерацию и векторизуются, затем полосы сворачиваются в 64-битный хеш
+SIMPLE_VECTOR_SIMD_CLONES inline uint64_t HashBytes(const unsigned char* data, size_t size) noexcept {
+    constexpr size_t lanes = 16;
+    constexpr uint32_t prime = 0x9E3779B1u;
+    uint32_t acc[lanes];
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        acc[lane] = static_cast<uint32_t>(lane + 1) * 0x85EBCA77u;
+    }
+    size_t i = 0;
+    for (; i + lanes * sizeof(uint32_t) <= size; i += lanes * sizeof(uint32_t)) {
+        uint32_t words[lanes];
+        std::memcpy(words, data + i, sizeof(words));
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            acc[lane] = (acc[lane] ^ words[lane]) * prime;
+        }
+    }
+    uint64_t hash = size;
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        hash = (hash ^ acc[lane]) * 0x100000001B3ull;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ data[i]) * 0x100000001B3ull;
+    }
+    // Финальное перемешивание splitmix64
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBull;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+// Возвращает указатель на первый элемент [first, last), равный value, либо last
+template <typename Type>
+const Type* Find(const Type* first, const Type* last, const Type& value) {
+    if constexpr (IsVectorizableV<Type>) {
+        return first + FindIndex(first, static_cast<size_t>(last - first), value);
+    }
+    else {
+        return std::find(first, last, value);
+    }
+}
+
+// Возвращает количество элементов [first, last), равных value
+template <typename Type>
+size_t Count(const Type* first, const Type* last, const Type& value) {
+    if constexpr (IsVectorizableV<Type>) {
+        return CountEqual(first, static_cast<size_t>(last - first), value);
+    }
+    else {
+        return static_cast<size_t>(std::count(first, last, value));
+    }
+}
+
+// Сравнивает на равенство массивы lhs и rhs длины size
+template <typename Type>
+bool Equal(const Type* lhs, const Type* rhs, size_t size) {
+    if (size == 0) {
+        return true;
+    }
+    if constexpr (std::is_integral_v<Type>) {
+        // Для целых равенство значений совпадает с побайтовым
+        return std::memcmp(lhs, rhs, size * sizeof(Type)) == 0;
+    }
+    else if constexpr (IsVectorizableV<Type>) {
+        return MismatchIndex(lhs, rhs, size) == size;
+    }
+    else {
+        return std::equal(lhs, lhs + size, rhs);
+    }
+}
+
+// Лексикографически сравнивает массивы lhs и rhs
+template <typename Type>
+bool Less(const Type* lhs, size_t lhs_size, const Type* rhs, size_t rhs_size) {
+    if constexpr (IsVectorizableOrderedV<Type>) {
+        const size_t common = std::min(lhs_size, rhs_size);
+        const size_t index = common == 0 ? 0 : MismatchIndex(lhs, rhs, common);
+        if (index == common) {
+            return lhs_size < rhs_size;
+        }
+        return lhs[index] < rhs[index];
+    }
+    else {
+        return std::lexicographical_compare(lhs, lhs + lhs_size, rhs, rhs + rhs_size);
+    }
+}
+
+// Возвращает указатель на первый наименьший элемент [first, last), либо last для пустого диапазона
+template <typename Type>
+const Type* MinElement(const Type* first, const Type* last) {
+    if constexpr (IsVectorizableOrderedV<Type>) {
+        if (first == last) {
+            return last;
+        }
+        const size_t size = static_cast<size_t>(last - first);
+        return first + FindIndex(first, size, MinValue(first, size));
+    }
+    else {
+        return std::min_element(first, last);
+    }
+}
+
+// Возвращает указатель на первый наибольший элемент [first, last), либо last для пустого диапазона
+template <typename Type>
+const Type* MaxElement(const Type* first, const Type* last) {
+    if constexpr (IsVectorizableOrderedV<Type>) {
+        if (first == last) {
+            return last;
+        }
+        const size_t size = static_cast<size_t>(last - first);
+        return first + FindIndex(first, size, MaxValue(first, size));
+    }
+    else {
+        return std::max_element(first, last);
+    }
+}
+
+// Вычисляет хеш массива, согласованный с Equal: равные массивы имеют равные хеши
+template <typename Type>
+size_t Hash(const Type* data, size_t size) {
+    if constexpr (IsVectorizableOrderedV<Type>) {
+        return static_cast<size_t>(HashBytes(reinterpret_cast<const unsigned char*>(data), size * sizeof(Type)));
+    }
+    else {
+        size_t hash = size;
+        const std::hash<Type> hasher;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= hasher(data[i]) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+}
+
+} // namespace simd
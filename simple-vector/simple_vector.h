@@ -3,154 +3,328 @@
  
 #include <algorithm>
 #include "array_ptr.h"
+#include "constexpr_support.h"
+#include "first_touch.h"
+#include "growth_policy.h"
+#include "profiling.h"
+#include "relocation.h"
+#include "shrink_policy.h"
+#include "simd_kernels.h"
 #include <cassert>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
  
 class ReserveProxyObj {
 public:
-    ReserveProxyObj(size_t capacity_to_reserve);
+    SIMPLE_VECTOR_CONSTEXPR ReserveProxyObj(size_t capacity_to_reserve);
     
-    size_t GetNewCapacity();
+    SIMPLE_VECTOR_CONSTEXPR size_t GetNewCapacity();
     
 private:
     size_t new_capacity_;
 };
  
-template <typename Type>
-class SimpleVector {
+// Разрешает перегрузку только для итераторов, удовлетворяющих требованиям InputIterator
+template <typename It>
+using RequireInputIterator = std::enable_if_t<std::is_convertible_v<
+    typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>>;
+
+// В C++20 вектор можно создавать, изменять и сравнивать в константных выражениях
+// (см. constexpr_support.h). Find, Count, Contains, Min, Max и Hash используют SIMD
+// и доступны только во время выполнения
+template <typename Type, typename Allocator = MallocAllocator<Type>, typename GrowthPolicy = DoublingGrowth,
+          typename ShrinkPolicy = NeverShrink>
+class SimpleVector : private profiling::VectorProfile<> {
  
 public:
     using Iterator = Type*;
     using ConstIterator = const Type*;
+    using AllocatorType = Allocator;
+    using GrowthPolicyType = GrowthPolicy;
+    using ShrinkPolicyType = ShrinkPolicy;
  
-    SimpleVector() noexcept = default; 
-    explicit SimpleVector(size_t size); 
-    SimpleVector(size_t size, const Type& value); 
-    SimpleVector(std::initializer_list<Type> init);    
-    SimpleVector(const SimpleVector& other);    
-    SimpleVector(SimpleVector&& other);    
-    SimpleVector(ReserveProxyObj value);
+    // Параметры location и site — место создания вектора для профилировщика (см. profiling.h).
+    // Их не нужно передавать явно: по умолчанию подставляется место вызова конструктора.
+    // Копия вектора относится к месту создания оригинала
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(CreationSite site = SourceLocation::Current()) noexcept;
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(const Allocator& alloc, SourceLocation location = SourceLocation::Current()) noexcept;
+    // Конструкторы по размеру и копирующие конструкторы создают элементы больших
+    // массивов несколькими потоками (см. first_touch.h)
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(size_t size, const Allocator& alloc = Allocator(),
+                                                  SourceLocation location = SourceLocation::Current()); 
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator(),
+                                         SourceLocation location = SourceLocation::Current()); 
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator(),
+                                         SourceLocation location = SourceLocation::Current());    
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other);    
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other, const Allocator& alloc);
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& other) noexcept;    
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(ReserveProxyObj value, const Allocator& alloc = Allocator(),
+                                         SourceLocation location = SourceLocation::Current());
+
+    SIMPLE_VECTOR_CONSTEXPR ~SimpleVector();
+
+    // Возвращает копию аллокатора, из которого вектор получает память
+    SIMPLE_VECTOR_CONSTEXPR Allocator GetAllocator() const noexcept;
+
+    // Возвращает выравнивание начала буфера, гарантированное аллокатором при любом
+    // выделении и перевыделении. Позволяет векторизованному коду пропустить пролог
+    static constexpr size_t GetAlignment() noexcept;
     
     // Возвращает количество элементов в массиве
-    size_t GetSize() const noexcept;
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept;
 
     // Возвращает вместимость массива
-    size_t GetCapacity() const noexcept;
+    SIMPLE_VECTOR_CONSTEXPR size_t GetCapacity() const noexcept;
  
     // Сообщает, пустой ли массив
-    bool IsEmpty() const noexcept;
+    SIMPLE_VECTOR_CONSTEXPR bool IsEmpty() const noexcept;
  
-    // Обнуляет размер массива, не изменяя его вместимость
-    void Clear() noexcept;
-
-    // Изменяет вместимость массива, при условии, что новая вместимость больше, чем текущая
-    void Reserve(size_t new_capacity);
+    // Разрушает элементы и обнуляет размер массива.
+    // Вместимость не изменяется, если ShrinkPolicy не велит вернуть память
+    SIMPLE_VECTOR_CONSTEXPR void Clear() noexcept;
+
+    // Изменяет вместимость массива, при условии, что новая вместимость больше, чем текущая.
+    // Новая память остаётся неинициализированной, переносятся только элементы [0, size).
+    // Если память перевыделена, в профиле вектор переходит к месту вызова Reserve
+    SIMPLE_VECTOR_CONSTEXPR void Reserve(size_t new_capacity, SourceLocation location = SourceLocation::Current());
+
+    // Уменьшает вместимость до размера массива, возвращая лишнюю память аллокатору.
+    // Пустой вектор освобождает буфер целиком
+    SIMPLE_VECTOR_CONSTEXPR void ShrinkToFit();
  
     // Изменяет размер массива.
     // При увеличении размера новые элементы получают значение по умолчанию для типа Type
-    void Resize(size_t new_size);
+    // (для больших массивов элементы создаются несколькими потоками, см. first_touch.h).
+    // При нехватке места вместимость растёт согласно GrowthPolicy, поэтому
+    // последовательные вызовы Resize выполняются за амортизированное O(1) на элемент
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size);
 
     // Добавляет элемент в конец вектора
-    // При нехватке места увеличивает вдвое вместимость вектора
-    void PushBack(const Type& item);
+    // При нехватке места увеличивает вместимость вектора согласно GrowthPolicy
+    // (по умолчанию вдвое)
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(const Type& item);
+
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(Type&& item);
 
-    void PushBack(Type&& item);
+    // Создаёт элемент из аргументов args непосредственно в конце вектора.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type& EmplaceBack(Args&&... args);
 
     // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
-    void PopBack() noexcept;
+    SIMPLE_VECTOR_CONSTEXPR void PopBack() noexcept;
 
     // Вставляет значение value в позицию pos.
     // Возвращает итератор на вставленное значение
-    // Если перед вставкой значения вектор был заполнен полностью,
-    // вместимость вектора должна увеличиться вдвое, а для вектора вместимостью 0 стать равной 1
-    Iterator Insert(ConstIterator pos, const Type& value);
-
-    Iterator Insert(ConstIterator pos, Type&& value);
-
-    // Удаляет элемент вектора в указанной позиции
-    Iterator Erase(ConstIterator pos);
+    // Если перед вставкой значения вектор был заполнен полностью, вместимость вектора
+    // увеличивается согласно GrowthPolicy: по умолчанию вдвое, а для вектора вместимостью 0 до 1
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, const Type& value);
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, Type&& value);
+
+    // Создаёт элемент из аргументов args непосредственно в позиции pos.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Emplace(ConstIterator pos, Args&&... args);
+
+    // Вставляет count копий value в позицию pos.
+    // Вместимость увеличивается не более одного раза, хвост сдвигается один раз.
+    // Возвращает итератор на первый вставленный элемент
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, size_t count, const Type& value);
+
+    // Вставляет элементы диапазона [first, last) в позицию pos. Диапазон не должен
+    // указывать на элементы этого вектора. Для однонаправленных итераторов вместимость
+    // увеличивается не более одного раза, хвост сдвигается один раз.
+    // Возвращает итератор на первый вставленный элемент
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, InputIt first, InputIt last);
+
+    // Добавляет элементы диапазона [first, last) в конец вектора
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    SIMPLE_VECTOR_CONSTEXPR void Append(InputIt first, InputIt last);
+
+    // Добавляет в конец вектора копии элементов other. other может совпадать с этим вектором
+    SIMPLE_VECTOR_CONSTEXPR void Append(const SimpleVector& other);
+
+    // Добавляет в конец вектора count элементов, которые fill(dest) создаёт в неинициализированной
+    // памяти dest. При нехватке места fill пишет прямо в новый буфер, поэтому пустой вектор
+    // заполняется за одно выделение памяти. При исключении fill сам разрушает созданное
+    template <typename Fill>
+    SIMPLE_VECTOR_CONSTEXPR void AppendInPlace(size_t count, Fill fill);
+
+    // Удаляет элемент вектора в указанной позиции.
+    // Если ShrinkPolicy вернула память, все прежние итераторы становятся недействительными
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator pos);
+
+    // Удаляет элементы диапазона [first, last), сдвигая хвост один раз.
+    // Возвращает итератор на элемент, следовавший за удалёнными
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator first, ConstIterator last);
 
     // Обменивает значение с другим вектором
-    void Swap(SimpleVector& other) noexcept;
+    SIMPLE_VECTOR_CONSTEXPR void Swap(SimpleVector& other) noexcept;
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    Type& At(size_t index);
+    SIMPLE_VECTOR_CONSTEXPR Type& At(size_t index);
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    const Type& At(size_t index) const;
+    SIMPLE_VECTOR_CONSTEXPR const Type& At(size_t index) const;
+
+    // Возвращает итератор на первый элемент, равный value, либо end()
+    Iterator Find(const Type& value) noexcept(simd::IsNothrowEqualV<Type>);
+
+    ConstIterator Find(const Type& value) const noexcept(simd::IsNothrowEqualV<Type>);
+
+    // Возвращает количество элементов, равных value
+    size_t Count(const Type& value) const noexcept(simd::IsNothrowEqualV<Type>);
+
+    // Сообщает, содержит ли вектор элемент, равный value
+    bool Contains(const Type& value) const noexcept(simd::IsNothrowEqualV<Type>);
+
+    // Возвращает итератор на первый наименьший элемент, либо end() для пустого вектора
+    ConstIterator Min() const noexcept(simd::IsNothrowLessV<Type>);
+
+    // Возвращает итератор на первый наибольший элемент, либо end() для пустого вектора
+    ConstIterator Max() const noexcept(simd::IsNothrowLessV<Type>);
+
+    // Возвращает хеш содержимого вектора. Равные векторы имеют равные хеши
+    size_t Hash() const noexcept(simd::IsNothrowHashV<Type>);
 
     // Возвращает итератор на начало массива
-    Iterator begin() noexcept;
+    SIMPLE_VECTOR_CONSTEXPR Iterator begin() noexcept;
 
     // Возвращает итератор на элемент, следующий за последним
-    Iterator end() noexcept;
+    SIMPLE_VECTOR_CONSTEXPR Iterator end() noexcept;
 
     // Возвращает константный итератор на начало массива
-    ConstIterator begin() const noexcept;
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator begin() const noexcept;
 
     // Возвращает итератор на элемент, следующий за последним
-    ConstIterator end() const noexcept;
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator end() const noexcept;
 
     // Возвращает константный итератор на начало массива
-    ConstIterator cbegin() const noexcept;
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cbegin() const noexcept;
 
     // Возвращает итератор на элемент, следующий за последним
-    ConstIterator cend() const noexcept;
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cend() const noexcept;
  
     // Возвращает ссылку на элемент с индексом index
-    Type& operator[](size_t index) noexcept;
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept;
  
     // Возвращает константную ссылку на элемент с индексом index
-    const Type& operator[](size_t index) const noexcept;
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept;
 
-    SimpleVector& operator=(const SimpleVector& rhs);
+    // Копирует элементы rhs, сохраняя собственный аллокатор
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(const SimpleVector& rhs);
 
-    SimpleVector& operator=(SimpleVector&& rhs);
+    // Забирает буфер rhs вместе с аллокатором без выделения памяти, rhs остаётся пустым.
+    // Если аллокатор нельзя присвоить (как std::pmr::polymorphic_allocator), а аллокаторы
+    // векторов различны, элементы поэлементно перемещаются в память собственного аллокатора
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(SimpleVector&& rhs) noexcept(std::is_move_assignable_v<Allocator>
+        || std::allocator_traits<Allocator>::is_always_equal::value);
     
 private:
-    ArrayPtr<Type> simple_vector_;
+    ArrayPtr<Type, Allocator> simple_vector_;
     size_t size_ = 0;
     size_t capacity_ = 0;
+
+    // Вместимость, до которой по GrowthPolicy вырастает вектор, чтобы вместить required элементов
+    SIMPLE_VECTOR_CONSTEXPR size_t GrowCapacity(size_t required) const noexcept;
+
+    // Переносит элементы в буфер вместимостью new_capacity, которая не меньше size
+    SIMPLE_VECTOR_CONSTEXPR void Reallocate(size_t new_capacity);
+
+    // Уменьшает буфер, если этого требует ShrinkPolicy. При неудаче перевыделения
+    // вектор остаётся прежним
+    SIMPLE_VECTOR_CONSTEXPR void MaybeShrink() noexcept;
+
+    // Вставляет count элементов в позицию index. fill(dest) конструирует их
+    // в неинициализированной памяти dest и при исключении сам разрушает созданное
+    template <typename Fill>
+    SIMPLE_VECTOR_CONSTEXPR Iterator InsertN(size_t index, size_t count, Fill fill);
+
+    // Переносит элементы [index, size) на count позиций вправо, оставляя
+    // позиции [index, index + count) неинициализированными. Требует, чтобы size + count <= capacity
+    SIMPLE_VECTOR_CONSTEXPR void OpenGap(size_t index, size_t count);
+
+    // Сообщает, может ли один из args быть элементом вектора или его частью.
+    // В константном выражении указатели на разные объекты сравнивать нельзя, поэтому возвращает true
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR bool MayReferToElement(const Args&... args) const noexcept;
+
+    // Разрушает count элементов, начиная с buf
+    static SIMPLE_VECTOR_CONSTEXPR void Destroy(Type* buf, size_t count) noexcept;
+
+    // Заменяет буфер вектора буфером new_data вместимостью new_capacity,
+    // разрушая элементы старого буфера, если они не были перенесены побайтово.
+    // Элементы уже должны быть перенесены
+    SIMPLE_VECTOR_CONSTEXPR void ReplaceBuffer(ArrayPtr<Type, Allocator>& new_data, size_t new_capacity) noexcept;
 };
  
-ReserveProxyObj Reserve(size_t capacity_to_reserve) {
+SIMPLE_VECTOR_CONSTEXPR ReserveProxyObj Reserve(size_t capacity_to_reserve) {
     return ReserveProxyObj(capacity_to_reserve);
 }
+
+namespace pmr {
+
+// SimpleVector, получающий память из std::pmr::memory_resource
+template <typename Type, typename GrowthPolicy = DoublingGrowth, typename ShrinkPolicy = NeverShrink>
+using SimpleVector = ::SimpleVector<Type, std::pmr::polymorphic_allocator<Type>, GrowthPolicy, ShrinkPolicy>;
+
+} // namespace pmr
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+struct std::hash<SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>> {
+    size_t operator()(const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& value) const noexcept(simd::IsNothrowHashV<Type>) {
+        return value.Hash();
+    }
+};
+
+// SimpleVector, буфер которого всегда выровнен по границе Alignment байт
+template <typename Type, size_t Alignment = CACHE_LINE_ALIGNMENT>
+using AlignedSimpleVector = SimpleVector<Type, AlignedAllocator<Type, Alignment>>;
  
-template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR bool operator==(const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& rhs) {
+    if (IsConstantEvaluated()) {
+        return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    return lhs.GetSize() == rhs.GetSize() && simd::Equal(lhs.begin(), rhs.begin(), lhs.GetSize());
 }
  
-template <typename Type>
-inline bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR bool operator!=(const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& rhs) {
     return !(lhs == rhs);
 }
  
-template <typename Type>
-inline bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
-                                        [] (const auto& lhs_value, const auto& rhs_value) {
-        return lhs_value < rhs_value;
-    });
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR bool operator<(const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& rhs) {
+    if (IsConstantEvaluated()) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    return simd::Less(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
 }
  
-template <typename Type>
-inline bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR bool operator<=(const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& rhs) {
     return !(rhs < lhs);
 }
  
-template <typename Type>
-inline bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR bool operator>(const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& rhs) {
     return rhs < lhs;
 }
  
-template <typename Type>
-inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR bool operator>=(const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& rhs) {
     return !(lhs < rhs);
 }
 
@@ -158,263 +332,636 @@ inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>&
 
 // ------------------ReserveProxyObj-----------------
 
-ReserveProxyObj::ReserveProxyObj(size_t capacity_to_reserve) : new_capacity_(capacity_to_reserve) {}
+SIMPLE_VECTOR_CONSTEXPR ReserveProxyObj::ReserveProxyObj(size_t capacity_to_reserve) : new_capacity_(capacity_to_reserve) {}
 
-size_t ReserveProxyObj::GetNewCapacity() {
+SIMPLE_VECTOR_CONSTEXPR size_t ReserveProxyObj::GetNewCapacity() {
     return new_capacity_;
 }
 
 // -------------------SimpleVector-------------------
 
-template <typename Type>
-SimpleVector<Type>::SimpleVector(size_t size)
-    : simple_vector_(size), size_(size), capacity_(size) {
-    for (auto it = begin(); it != end(); ++it) {
-        *it = Type{};
-    }
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::SimpleVector(CreationSite site) noexcept
+    : VectorProfile(site.location) {
 }
 
-template <typename Type>
-SimpleVector<Type>::SimpleVector(size_t size, const Type& value)
-    : simple_vector_(size), size_(size), capacity_(size) {
-    for (auto it = begin(); it != end(); ++it) {
-        *it = value;
-    }
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::SimpleVector(const Allocator& alloc, SourceLocation location) noexcept
+    : VectorProfile(location), simple_vector_(alloc) {
 }
 
-template <typename Type>
-SimpleVector<Type>::SimpleVector(std::initializer_list<Type> init)
-    : simple_vector_(init.size()), size_(init.size()), capacity_(init.size()) {
-    std::copy(std::make_move_iterator(init.begin()), std::make_move_iterator(init.end()), begin());
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::SimpleVector(size_t size, const Allocator& alloc, SourceLocation location)
+    : VectorProfile(location), simple_vector_(size, alloc), capacity_(size) {
+    OnCapacityChange(0, size);
+    Type* data = simple_vector_.Get();
+    ParallelUninitializedConstruct(data, size, [data](size_t first, size_t last) {
+        UninitializedValueConstruct(data + first, data + last);
+    });
+    size_ = size;
 }
 
-template <typename Type>
-SimpleVector<Type>::SimpleVector(const SimpleVector& other) {
-    ArrayPtr<Type> temp(other.size_);
-    std::copy(other.begin(), other.end(), temp.Get());
-    simple_vector_.Swap(temp);
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::SimpleVector(size_t size, const Type& value, const Allocator& alloc, SourceLocation location)
+    : VectorProfile(location), simple_vector_(size, alloc), capacity_(size) {
+    OnCapacityChange(0, size);
+    Type* data = simple_vector_.Get();
+    ParallelUninitializedConstruct(data, size, [data, &value](size_t first, size_t last) {
+        UninitializedFillN(data + first, last - first, value);
+    });
+    size_ = size;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::SimpleVector(std::initializer_list<Type> init, const Allocator& alloc, SourceLocation location)
+    : VectorProfile(location), simple_vector_(init.size(), alloc), capacity_(init.size()) {
+    OnCapacityChange(0, init.size());
+    UninitializedCopy(init.begin(), init.end(), simple_vector_.Get());
+    size_ = init.size();
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::SimpleVector(const SimpleVector& other)
+    : SimpleVector(other, std::allocator_traits<Allocator>::select_on_container_copy_construction(
+        other.simple_vector_.GetAllocator())) {
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::SimpleVector(const SimpleVector& other, const Allocator& alloc)
+    : VectorProfile(other), simple_vector_(other.size_, alloc) {
+    OnCapacityChange(0, other.size_);
+    Type* data = simple_vector_.Get();
+    const Type* source = other.begin();
+    ParallelUninitializedConstruct(data, other.size_, [data, source](size_t first, size_t last) {
+        UninitializedCopy(source + first, source + last, data + first);
+    });
     size_ = other.size_;
-    capacity_ = other.capacity_;
+    capacity_ = other.size_;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::SimpleVector(SimpleVector&& other) noexcept
+    : VectorProfile(std::move(other))
+    , simple_vector_(std::move(other.simple_vector_))
+    , size_(std::exchange(other.size_, 0))
+    , capacity_(std::exchange(other.capacity_, 0)) {
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::SimpleVector(ReserveProxyObj value, const Allocator& alloc, SourceLocation location)
+    : VectorProfile(location), simple_vector_(alloc) {
+    Reserve(value.GetNewCapacity(), location);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::~SimpleVector() {
+    OnDestroy(size_, sizeof(Type));
+    Destroy(simple_vector_.Get(), size_);
 }
 
-template <typename Type>
-SimpleVector<Type>::SimpleVector(SimpleVector&& other) {
-    simple_vector_ = (std::move(other.simple_vector_));
-    size_ = std::exchange(other.size_, 0);
-    capacity_ = std::exchange(other.capacity_, 0);
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR Allocator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::GetAllocator() const noexcept {
+    return simple_vector_.GetAllocator();
 }
 
-template <typename Type>
-SimpleVector<Type>::SimpleVector(ReserveProxyObj value) {
-    Reserve(value.GetNewCapacity());
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+constexpr size_t SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::GetAlignment() noexcept {
+    return GuaranteedAlignmentV<Allocator>;
 }
 
-template <typename Type>
-size_t SimpleVector<Type>::GetSize() const noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR size_t SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::GetSize() const noexcept {
     return size_;
 }
 
-template <typename Type>
-size_t SimpleVector<Type>::GetCapacity() const noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR size_t SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::GetCapacity() const noexcept {
     return capacity_;
 }
 
-template <typename Type>
-bool SimpleVector<Type>::IsEmpty() const noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR bool SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::IsEmpty() const noexcept {
     return (size_ == 0);
 }
 
-template <typename Type>
-void SimpleVector<Type>::Clear() noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Clear() noexcept {
+    Destroy(simple_vector_.Get(), size_);
     size_ = 0;
+    MaybeShrink();
 }
 
-template <typename Type>
-void SimpleVector<Type>::Reserve(size_t new_capacity) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Reserve(size_t new_capacity, SourceLocation location) {
     if (new_capacity > capacity_) {
-        auto temp_size = size_;
-        SimpleVector temp(new_capacity);
-        std::copy(std::make_move_iterator(begin()), std::make_move_iterator(end()), temp.begin());
-        Swap(temp);
-        size_ = temp_size;
+        Reallocate(new_capacity);
+        OnReserve(location);
     }
 }
 
-template <typename Type>
-void SimpleVector<Type>::Resize(size_t new_size) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::ShrinkToFit() {
+    if (capacity_ > size_) {
+        Reallocate(size_);
+    }
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Resize(size_t new_size) {
     if (new_size <= size_) {
+        Destroy(simple_vector_.Get() + new_size, size_ - new_size);
         size_ = new_size;
+        MaybeShrink();
         return;
     }
-    else if (new_size < capacity_) {
-        for (auto it = end(); it != begin() + new_size; ++it) {
-            *it = Type{};
-        }
-        size_ = new_size;
-        return;
-    }
-    else {
-        ArrayPtr<Type> temp(new_size);
-        for (auto it = temp.Get(); it != temp.Get() + new_size; ++it) {
-            *it = Type{};
-        }
-        std::copy(begin(), end(), temp.Get());
-        simple_vector_.Swap(temp);
-        size_ = new_size;
-        capacity_ = new_size;
-        return;
+    if (new_size > capacity_) {
+        Reallocate(GrowCapacity(new_size));
     }
+    Type* tail = end();
+    ParallelUninitializedConstruct(tail, new_size - size_, [tail](size_t first, size_t last) {
+        UninitializedValueConstruct(tail + first, tail + last);
+    });
+    size_ = new_size;
 }
 
-template <typename Type>
-void SimpleVector<Type>::PushBack(const Type& item) {
-    if (capacity_ == 0) {
-        Reserve(1);
-    }
-    else if (size_ == capacity_) {
-        Reserve(size_ * 2);
-    }
-    simple_vector_[size_] = item;
-    ++size_;
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::PushBack(const Type& item) {
+    EmplaceBack(item);
 }
 
-template <typename Type>
-void SimpleVector<Type>::PushBack(Type&& item) {
-    if (capacity_ == 0) {
-        Reserve(1);
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::PushBack(Type&& item) {
+    EmplaceBack(std::move(item));
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+template <typename... Args>
+SIMPLE_VECTOR_CONSTEXPR Type& SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::EmplaceBack(Args&&... args) {
+    if (size_ == capacity_) {
+        // Новый элемент создаётся до переноса старых, так как args могут ссылаться на элементы вектора
+        const size_t new_capacity = GrowCapacity(size_ + 1);
+        ArrayPtr<Type, Allocator> new_data(new_capacity, simple_vector_.GetAllocator());
+        ConstructAt(new_data.Get() + size_, std::forward<Args>(args)...);
+        try {
+            UninitializedRelocate(simple_vector_.Get(), size_, new_data.Get());
+        } catch (...) {
+            new_data[size_].~Type();
+            throw;
+        }
+        ReplaceBuffer(new_data, new_capacity);
     }
-    else if (size_ == capacity_) {
-        Reserve(size_ * 2);
+    else {
+        ConstructAt(end(), std::forward<Args>(args)...);
     }
-    simple_vector_[size_] = std::move(item);
     ++size_;
+    return simple_vector_[size_ - 1];
 }
 
-template <typename Type>
-void SimpleVector<Type>::PopBack() noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::PopBack() noexcept {
     assert(size_ != 0);
     --size_;
+    simple_vector_[size_].~Type();
+    MaybeShrink();
 }
 
-template <typename Type>
-typename SimpleVector<Type>::Iterator SimpleVector<Type>::Insert(ConstIterator pos, const Type& value) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Iterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Insert(ConstIterator pos, const Type& value) {
+    return Emplace(pos, value);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Iterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Insert(ConstIterator pos, Type&& value) {
+    return Emplace(pos, std::move(value));
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+template <typename... Args>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Iterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Emplace(ConstIterator pos, Args&&... args) {
     assert(begin() <= pos && pos <= end());
-    auto delta = pos - begin();
-    if (size_ < capacity_) {
-        std::copy_backward(begin() + delta, end(), end() + 1);
-        simple_vector_[delta] = value;
+    const size_t delta = pos - cbegin();
+    if (delta == size_) {
+        EmplaceBack(std::forward<Args>(args)...);
+        return begin() + delta;
+    }
+    if (size_ == capacity_) {
+        const size_t new_capacity = GrowCapacity(size_ + 1);
+        ArrayPtr<Type, Allocator> new_data(new_capacity, simple_vector_.GetAllocator());
+        ConstructAt(new_data.Get() + delta, std::forward<Args>(args)...);
+        try {
+            UninitializedRelocate(simple_vector_.Get(), delta, new_data.Get());
+            try {
+                UninitializedRelocate(simple_vector_.Get() + delta, size_ - delta, new_data.Get() + delta + 1);
+            } catch (...) {
+                Destroy(new_data.Get(), delta);
+                throw;
+            }
+        } catch (...) {
+            new_data[delta].~Type();
+            throw;
+        }
+        ReplaceBuffer(new_data, new_capacity);
+    }
+    else if constexpr (IsTriviallyRelocatableV<Type>) {
+        // args могут ссылаться на элементы вектора, поэтому элемент создаётся до сдвига
+        // во временной памяти и затем переносится на место побайтово
+        if (IsConstantEvaluated()) {
+            Type temp(std::forward<Args>(args)...);
+            OpenGap(delta, 1);
+            ConstructAt(simple_vector_.Get() + delta, std::move(temp));
+        }
+        else {
+            alignas(Type) unsigned char temp[sizeof(Type)];
+            new (temp) Type(std::forward<Args>(args)...);
+            OpenGap(delta, 1);
+            RelocateBytes(reinterpret_cast<Type*>(temp), 1, simple_vector_.Get() + delta);
+        }
+    }
+    else if (!MayReferToElement(args...)) {
+        return InsertN(delta, 1, [&](Type* dest) {
+            ConstructAt(dest, std::forward<Args>(args)...);
+        });
     }
     else {
-        Reserve(std::max(capacity_ * 2, (size_t)1)); // если capacity_ == 0, то зарезирвировать 1; иначе capacity_ * 2
-        std::copy_backward(begin() + delta, end(), end() + 1);
-        simple_vector_[delta] = value;
+        // Сдвиг хвоста изменил бы элемент, на который ссылаются args
+        Type temp(std::forward<Args>(args)...);
+        return InsertN(delta, 1, [&temp](Type* dest) {
+            ConstructAt(dest, std::move(temp));
+        });
     }
     ++size_;
     return begin() + delta;
 }
 
-template <typename Type>
-typename SimpleVector<Type>::Iterator SimpleVector<Type>::Insert(ConstIterator pos, Type&& value) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Iterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Insert(ConstIterator pos, size_t count, const Type& value) {
+    assert(begin() <= pos && pos <= end());
+    const size_t index = pos - cbegin();
+    // value может ссылаться на элемент вектора, который сместится при сдвиге хвоста.
+    // В константном выражении указатели на разные объекты сравнивать нельзя,
+    // поэтому там value копируется всегда
+    const std::less<const Type*> less;
+    if (count <= capacity_ - size_ && (IsConstantEvaluated() || (!less(&value, cbegin()) && less(&value, cend())))) {
+        Type temp(value);
+        return InsertN(index, count, [&temp, count](Type* dest) {
+            UninitializedFillN(dest, count, temp);
+        });
+    }
+    return InsertN(index, count, [&value, count](Type* dest) {
+        UninitializedFillN(dest, count, value);
+    });
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+template <typename InputIt, typename>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Iterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Insert(ConstIterator pos, InputIt first, InputIt last) {
     assert(begin() <= pos && pos <= end());
-    auto delta = pos - begin();
-    if (size_ < capacity_) {
-        std::move_backward(std::make_move_iterator(begin() + delta), std::make_move_iterator(end()), end() + 1);
-        simple_vector_[(size_t)delta] = std::move(value);
+    const size_t index = pos - cbegin();
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+        const size_t count = std::distance(first, last);
+        return InsertN(index, count, [first, last](Type* dest) {
+            UninitializedCopy(first, last, dest);
+        });
     }
     else {
-        Reserve(std::max(capacity_ * 2, (size_t)1));
-        std::move_backward(std::make_move_iterator(begin() + delta), std::make_move_iterator(end()), end() + 1);
-        simple_vector_[(size_t)delta] = std::move(value);
+        // Длину однопроходного диапазона нельзя узнать заранее, поэтому он сначала
+        // собирается во временный вектор
+        SimpleVector temp(simple_vector_.GetAllocator(), SourceLocation{});
+        for (; first != last; ++first) {
+            temp.EmplaceBack(*first);
+        }
+        return InsertN(index, temp.size_, [&temp](Type* dest) {
+            UninitializedRelocate(temp.begin(), temp.size_, dest);
+        });
     }
-    ++size_;
-    return begin() + delta;
 }
 
-template <typename Type>
-typename SimpleVector<Type>::Iterator SimpleVector<Type>::Erase(ConstIterator pos) {
-    assert(size_ != 0);
-    std::move(const_cast<Iterator>(pos) + 1, end(), const_cast<Iterator>(pos));
-    --size_;
-    return const_cast<Iterator>(pos);
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+template <typename InputIt, typename>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Append(InputIt first, InputIt last) {
+    Insert(cend(), first, last);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Append(const SimpleVector& other) {
+    // При вставке в конец хвост не сдвигается, а при росте копии создаются
+    // до освобождения старого буфера, поэтому other может совпадать с *this
+    Insert(cend(), other.begin(), other.end());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+template <typename Fill>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::AppendInPlace(size_t count, Fill fill) {
+    InsertN(size_, count, std::move(fill));
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Iterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Erase(ConstIterator pos) {
+    assert(begin() <= pos && pos < end());
+    const size_t index = pos - cbegin();
+    const auto it = begin() + index;
+    instrumentation::OnShift<Type>(size_ - index - 1);
+    if constexpr (IsTriviallyRelocatableV<Type>) {
+        it->~Type();
+        ShiftBytes(it + 1, end() - it - 1, it);
+        --size_;
+        MaybeShrink();
+    }
+    else {
+        std::move(it + 1, end(), it);
+        PopBack();
+    }
+    // Буфер мог переместиться, если ShrinkPolicy вернула память
+    return begin() + index;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Iterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Erase(ConstIterator first, ConstIterator last) {
+    assert(cbegin() <= first && first <= last && last <= cend());
+    const size_t index = first - cbegin();
+    const auto it = begin() + index;
+    const size_t count = last - first;
+    if (count == 0) {
+        return it;
+    }
+    instrumentation::OnShift<Type>(size_ - index - count);
+    if constexpr (IsTriviallyRelocatableV<Type>) {
+        std::destroy_n(it, count);
+        ShiftBytes(it + count, end() - it - count, it);
+    }
+    else {
+        std::move(it + count, end(), it);
+        std::destroy_n(end() - count, count);
+    }
+    size_ -= count;
+    MaybeShrink();
+    return begin() + index;
 }
 
-template <typename Type>
-void SimpleVector<Type>::Swap(SimpleVector& other) noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Swap(SimpleVector& other) noexcept {
+    VectorProfile::Swap(other);
     simple_vector_.Swap(other.simple_vector_);
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
 }
 
-template <typename Type>
-Type& SimpleVector<Type>::At(size_t index) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR Type& SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::At(size_t index) {
     if (!(index < size_))
         throw std::out_of_range("The index value is out of range");
     return simple_vector_[index];
 }
 
-template <typename Type>
-const Type& SimpleVector<Type>::At(size_t index) const {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR const Type& SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::At(size_t index) const {
     if (!(index < size_))
         throw std::out_of_range("The index value is out of range");
     return simple_vector_[index];
 }
 
-template <typename Type>
-Type& SimpleVector<Type>::operator[](size_t index) noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR Type& SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::operator[](size_t index) noexcept {
     assert(index < size_);
     return simple_vector_[index];
 }
 
-template <typename Type>
-const Type& SimpleVector<Type>::operator[](size_t index) const noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR const Type& SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::operator[](size_t index) const noexcept {
     assert(index < size_);
     return simple_vector_[index];
 }
 
-template <typename Type>
-SimpleVector<Type>& SimpleVector<Type>::operator=(const SimpleVector& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::operator=(const SimpleVector& rhs) {
     if (this != &rhs) {
-        SimpleVector temp(rhs);
+        SimpleVector temp(rhs, simple_vector_.GetAllocator());
         Swap(temp);
     }
     return *this;
 }
 
-template<typename Type>
-SimpleVector<Type>& SimpleVector<Type>::operator=(SimpleVector&& rhs) {
-    if (this != &rhs) {
-        SimpleVector temp(rhs);
-        Swap(temp);
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::operator=(SimpleVector&& rhs) noexcept(
+    std::is_move_assignable_v<Allocator> || std::allocator_traits<Allocator>::is_always_equal::value) {
+    if (this == &rhs) {
+        return *this;
     }
+    if constexpr (!std::is_move_assignable_v<Allocator> && !std::allocator_traits<Allocator>::is_always_equal::value) {
+        if (simple_vector_.GetAllocator() != rhs.simple_vector_.GetAllocator()) {
+            SimpleVector temp(simple_vector_.GetAllocator(), rhs.GetLocation());
+            temp.Reallocate(rhs.size_);
+            UninitializedMoveN(rhs.begin(), rhs.size_, temp.simple_vector_.Get());
+            temp.size_ = rhs.size_;
+            Swap(temp);
+            rhs.Clear();
+            return *this;
+        }
+    }
+    SimpleVector temp(std::move(rhs));
+    Swap(temp);
     return *this;
 }
 
-template <typename Type>
-typename SimpleVector<Type>::Iterator SimpleVector<Type>::begin() noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Iterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Find(const Type& value) noexcept(simd::IsNothrowEqualV<Type>) {
+    return begin() + (std::as_const(*this).Find(value) - cbegin());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::ConstIterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Find(const Type& value) const noexcept(simd::IsNothrowEqualV<Type>) {
+    return simd::Find(cbegin(), cend(), value);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+size_t SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Count(const Type& value) const noexcept(simd::IsNothrowEqualV<Type>) {
+    return simd::Count(cbegin(), cend(), value);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+bool SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Contains(const Type& value) const noexcept(simd::IsNothrowEqualV<Type>) {
+    return Find(value) != cend();
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::ConstIterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Min() const noexcept(simd::IsNothrowLessV<Type>) {
+    return simd::MinElement(cbegin(), cend());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::ConstIterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Max() const noexcept(simd::IsNothrowLessV<Type>) {
+    return simd::MaxElement(cbegin(), cend());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+size_t SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Hash() const noexcept(simd::IsNothrowHashV<Type>) {
+    return simd::Hash(cbegin(), size_);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Iterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::begin() noexcept {
     return simple_vector_.Get();
 }
 
-template <typename Type>
-typename SimpleVector<Type>::Iterator SimpleVector<Type>::end() noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Iterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::end() noexcept {
     return simple_vector_.Get() + size_;
 }
 
-template<typename Type>
-typename SimpleVector<Type>::ConstIterator SimpleVector<Type>::begin() const noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::ConstIterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::begin() const noexcept {
     return simple_vector_.Get();
 }
 
-template <typename Type>
-typename SimpleVector<Type>::ConstIterator SimpleVector<Type>::end() const noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::ConstIterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::end() const noexcept {
     return simple_vector_.Get() + size_;
 }
 
-template <typename Type>
-typename SimpleVector<Type>::ConstIterator SimpleVector<Type>::cbegin() const noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::ConstIterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::cbegin() const noexcept {
     return simple_vector_.Get();
 }
 
-template <typename Type>
-typename SimpleVector<Type>::ConstIterator SimpleVector<Type>::cend() const noexcept {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::ConstIterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::cend() const noexcept {
     return simple_vector_.Get() + size_;
-}
\ No newline at end of file
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR size_t SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::GrowCapacity(size_t required) const noexcept {
+    return GrowthPolicy::NextCapacity(capacity_, required, sizeof(Type));
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Destroy(Type* buf, size_t count) noexcept {
+    std::destroy_n(buf, count);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Reallocate(size_t new_capacity) {
+    assert(new_capacity >= size_);
+    if (new_capacity == 0) {
+        ArrayPtr<Type, Allocator> empty(simple_vector_.GetAllocator());
+        simple_vector_.Swap(empty);
+        capacity_ = 0;
+        return;
+    }
+    if constexpr (IsTriviallyRelocatableV<Type>) {
+        // realloc недоступен в константном выражении: там буфер заменяется новым
+        if (!IsConstantEvaluated()) {
+            simple_vector_.Reallocate(new_capacity);
+            instrumentation::OnReallocate<Type>(size_);
+            OnCapacityChange(capacity_, new_capacity);
+            capacity_ = new_capacity;
+            return;
+        }
+    }
+    ArrayPtr<Type, Allocator> new_data(new_capacity, simple_vector_.GetAllocator());
+    UninitializedRelocate(simple_vector_.Get(), size_, new_data.Get());
+    ReplaceBuffer(new_data, new_capacity);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::MaybeShrink() noexcept {
+    const size_t new_capacity = ShrinkPolicy::ShrinkCapacity(size_, capacity_);
+    if (new_capacity < capacity_) {
+        try {
+            Reallocate(new_capacity);
+        } catch (...) {
+            // Освобождение памяти — оптимизация: при неудаче сохраняем прежний буфер
+        }
+    }
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+template <typename Fill>
+SIMPLE_VECTOR_CONSTEXPR typename SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::Iterator SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::InsertN(size_t index, size_t count, Fill fill) {
+    if (count == 0) {
+        return begin() + index;
+    }
+    if (count > capacity_ - size_) {
+        const size_t new_capacity = GrowCapacity(size_ + count);
+        ArrayPtr<Type, Allocator> new_data(new_capacity, simple_vector_.GetAllocator());
+        fill(new_data.Get() + index);
+        try {
+            UninitializedRelocate(simple_vector_.Get(), index, new_data.Get());
+            try {
+                UninitializedRelocate(simple_vector_.Get() + index, size_ - index, new_data.Get() + index + count);
+            } catch (...) {
+                Destroy(new_data.Get(), index);
+                throw;
+            }
+        } catch (...) {
+            Destroy(new_data.Get() + index, count);
+            throw;
+        }
+        ReplaceBuffer(new_data, new_capacity);
+    }
+    else {
+        OpenGap(index, count);
+        try {
+            fill(simple_vector_.Get() + index);
+        } catch (...) {
+            if constexpr (IsTriviallyRelocatableV<Type>) {
+                ShiftBytes(simple_vector_.Get() + index + count, size_ - index, simple_vector_.Get() + index);
+            }
+            else {
+                // Сдвинутый хвост разрушается: вектор остаётся корректным, но короче
+                Destroy(simple_vector_.Get() + index + count, size_ - index);
+                size_ = index;
+            }
+            throw;
+        }
+    }
+    size_ += count;
+    return begin() + index;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::OpenGap(size_t index, size_t count) {
+    assert(index <= size_ && count <= capacity_ - size_);
+    instrumentation::OnShift<Type>(size_ - index);
+    Type* data = simple_vector_.Get();
+    if constexpr (IsTriviallyRelocatableV<Type>) {
+        ShiftBytes(data + index, size_ - index, data + index + count);
+    }
+    else {
+        for (size_t i = size_; i > index; --i) {
+            try {
+                ConstructAt(data + i - 1 + count, std::move_if_noexcept(data[i - 1]));
+            } catch (...) {
+                // Уже перенесённые элементы разрушаются: вектор остаётся корректным, но короче
+                Destroy(data + i + count, size_ - i);
+                size_ = i;
+                throw;
+            }
+            data[i - 1].~Type();
+        }
+    }
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+template <typename... Args>
+SIMPLE_VECTOR_CONSTEXPR bool SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::MayReferToElement(const Args&... args) const noexcept {
+    if (IsConstantEvaluated()) {
+        return true;
+    }
+    const std::less<const void*> less;
+    auto inside = [this, &less](const void* address) {
+        return !less(address, cbegin()) && less(address, cend());
+    };
+    return (inside(std::addressof(args)) || ...);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SIMPLE_VECTOR_CONSTEXPR void SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>::ReplaceBuffer(ArrayPtr<Type, Allocator>& new_data, size_t new_capacity) noexcept {
+    if constexpr (!IsTriviallyRelocatableV<Type>) {
+        Destroy(simple_vector_.Get(), size_);
+    }
+    instrumentation::OnReallocate<Type>(size_);
+    OnCapacityChange(capacity_, new_capacity);
+    simple_vector_.Swap(new_data);
+    capacity_ = new_capacity;
+}
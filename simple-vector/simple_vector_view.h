@@ -0,0 +1,292 @@
+#pragma once
+
+#include "simple_vector.h"
+#include "simd_kernels.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Разрешает перегрузку только для контейнеров с непрерывным хранением, чьи begin()
+// и GetSize() позволяют смотреть на элементы как на Type (SimpleVector, SmallSimpleVector,
+// MappedSimpleVector и другие представления)
+template <typename Container, typename Type>
+using RequireContiguousContainer = std::enable_if_t<
+    std::is_convertible_v<decltype(std::declval<Container&>().begin()), Type*>
+    && std::is_convertible_v<decltype(std::declval<Container&>().GetSize()), size_t>>;
+
+// Невладеющее представление непрерывного диапазона элементов: указатель и размер.
+// Копируется дёшево и передаётся по значению вместо пары итераторов или копии вектора.
+// SimpleVectorView<Type> позволяет изменять элементы, SimpleVectorView<const Type> — только читать.
+// SimpleVector неявно преобразуется в представление; представление действительно, пока
+// вектор не перевыделил буфер и не разрушен
+template <typename Type>
+class SimpleVectorView {
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Значение count для Subview, означающее «до конца представления»
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    SimpleVectorView() noexcept = default;
+
+    SimpleVectorView(Type* data, size_t size) noexcept;
+
+    SimpleVectorView(Type* first, Type* last) noexcept;
+
+    // Представление всех элементов контейнера. Временные контейнеры не принимаются,
+    // чтобы представление не пережило их
+    template <typename Container, typename = RequireContiguousContainer<Container, Type>>
+    SimpleVectorView(Container& container) noexcept;
+
+    // Представление изменяемых элементов преобразуется в представление константных
+    template <typename Other, typename = std::enable_if_t<std::is_convertible_v<Other (*)[], Type (*)[]>>>
+    SimpleVectorView(SimpleVectorView<Other> other) noexcept;
+
+    size_t GetSize() const noexcept;
+    bool IsEmpty() const noexcept;
+
+    // Возвращает представление count элементов, начиная с offset. count, выходящий за
+    // конец, сокращается до конца представления.
+    // Выбрасывает исключение std::out_of_range, если offset > size
+    SimpleVectorView Subview(size_t offset, size_t count = npos) const;
+
+    // Возвращает представление первых count элементов (всех, если count >= size)
+    SimpleVectorView First(size_t count) const noexcept;
+
+    // Возвращает представление последних count элементов (всех, если count >= size)
+    SimpleVectorView Last(size_t count) const noexcept;
+
+    // Делит представление на min(parts, size) непустых частей подряд. Размеры частей
+    // отличаются не более чем на 1, более длинные идут первыми. parts должно быть больше 0
+    SimpleVector<SimpleVectorView> Split(size_t parts) const;
+
+    Type& operator[](size_t index) const noexcept;
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) const;
+
+    Iterator begin() const noexcept;
+    Iterator end() const noexcept;
+    ConstIterator cbegin() const noexcept;
+    ConstIterator cend() const noexcept;
+
+private:
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template <typename Container>
+SimpleVectorView(Container&) -> SimpleVectorView<std::remove_pointer_t<decltype(std::declval<Container&>().begin())>>;
+
+// Разрешает сравнение представлений одного типа элементов независимо от их константности
+template <typename Left, typename Right>
+using RequireSameElement = std::enable_if_t<std::is_same_v<std::remove_const_t<Left>, std::remove_const_t<Right>>>;
+
+template <typename Left, typename Right, typename = RequireSameElement<Left, Right>>
+bool operator==(SimpleVectorView<Left> lhs, SimpleVectorView<Right> rhs) {
+    return lhs.GetSize() == rhs.GetSize() && simd::Equal(lhs.cbegin(), rhs.cbegin(), lhs.GetSize());
+}
+
+template <typename Left, typename Right, typename = RequireSameElement<Left, Right>>
+bool operator!=(SimpleVectorView<Left> lhs, SimpleVectorView<Right> rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Left, typename Right, typename = RequireSameElement<Left, Right>>
+bool operator<(SimpleVectorView<Left> lhs, SimpleVectorView<Right> rhs) {
+    return simd::Less(lhs.cbegin(), lhs.GetSize(), rhs.cbegin(), rhs.GetSize());
+}
+
+template <typename Left, typename Right, typename = RequireSameElement<Left, Right>>
+bool operator<=(SimpleVectorView<Left> lhs, SimpleVectorView<Right> rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Left, typename Right, typename = RequireSameElement<Left, Right>>
+bool operator>(SimpleVectorView<Left> lhs, SimpleVectorView<Right> rhs) {
+    return rhs < lhs;
+}
+
+template <typename Left, typename Right, typename = RequireSameElement<Left, Right>>
+bool operator>=(SimpleVectorView<Left> lhs, SimpleVectorView<Right> rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename Type>
+struct IsSimpleVectorView : std::false_type {};
+
+template <typename Type>
+struct IsSimpleVectorView<SimpleVectorView<Type>> : std::true_type {};
+
+// Разрешает сравнение представления с контейнером, который неявно преобразуется
+// в представление тех же элементов (SimpleVector, SmallSimpleVector и другие).
+// Шаблонные операторы представлений не выполняют такого преобразования сами
+template <typename Container, typename Type>
+using RequireComparableContainer = std::enable_if_t<!IsSimpleVectorView<Container>::value,
+                                                    RequireContiguousContainer<const Container, const std::remove_const_t<Type>>>;
+
+template <typename Type, typename Container, typename = RequireComparableContainer<Container, Type>>
+bool operator==(SimpleVectorView<Type> lhs, const Container& rhs) {
+    return lhs == SimpleVectorView<const std::remove_const_t<Type>>(rhs);
+}
+
+template <typename Container, typename Type, typename = RequireComparableContainer<Container, Type>>
+bool operator==(const Container& lhs, SimpleVectorView<Type> rhs) {
+    return rhs == lhs;
+}
+
+template <typename Type, typename Container, typename = RequireComparableContainer<Container, Type>>
+bool operator!=(SimpleVectorView<Type> lhs, const Container& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Container, typename Type, typename = RequireComparableContainer<Container, Type>>
+bool operator!=(const Container& lhs, SimpleVectorView<Type> rhs) {
+    return !(rhs == lhs);
+}
+
+template <typename Type, typename Container, typename = RequireComparableContainer<Container, Type>>
+bool operator<(SimpleVectorView<Type> lhs, const Container& rhs) {
+    return lhs < SimpleVectorView<const std::remove_const_t<Type>>(rhs);
+}
+
+template <typename Container, typename Type, typename = RequireComparableContainer<Container, Type>>
+bool operator<(const Container& lhs, SimpleVectorView<Type> rhs) {
+    return SimpleVectorView<const std::remove_const_t<Type>>(lhs) < rhs;
+}
+
+template <typename Type, typename Container, typename = RequireComparableContainer<Container, Type>>
+bool operator<=(SimpleVectorView<Type> lhs, const Container& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Container, typename Type, typename = RequireComparableContainer<Container, Type>>
+bool operator<=(const Container& lhs, SimpleVectorView<Type> rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Container, typename = RequireComparableContainer<Container, Type>>
+bool operator>(SimpleVectorView<Type> lhs, const Container& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Container, typename Type, typename = RequireComparableContainer<Container, Type>>
+bool operator>(const Container& lhs, SimpleVectorView<Type> rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Container, typename = RequireComparableContainer<Container, Type>>
+bool operator>=(SimpleVectorView<Type> lhs, const Container& rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename Container, typename Type, typename = RequireComparableContainer<Container, Type>>
+bool operator>=(const Container& lhs, SimpleVectorView<Type> rhs) {
+    return !(lhs < rhs);
+}
+
+// -----------------SimpleVectorView-----------------
+
+template <typename Type>
+SimpleVectorView<Type>::SimpleVectorView(Type* data, size_t size) noexcept
+    : data_(data), size_(size) {
+}
+
+template <typename Type>
+SimpleVectorView<Type>::SimpleVectorView(Type* first, Type* last) noexcept
+    : data_(first), size_(static_cast<size_t>(last - first)) {
+}
+
+template <typename Type>
+template <typename Container, typename>
+SimpleVectorView<Type>::SimpleVectorView(Container& container) noexcept
+    : data_(container.begin()), size_(container.GetSize()) {
+}
+
+template <typename Type>
+template <typename Other, typename>
+SimpleVectorView<Type>::SimpleVectorView(SimpleVectorView<Other> other) noexcept
+    : data_(other.begin()), size_(other.GetSize()) {
+}
+
+template <typename Type>
+size_t SimpleVectorView<Type>::GetSize() const noexcept {
+    return size_;
+}
+
+template <typename Type>
+bool SimpleVectorView<Type>::IsEmpty() const noexcept {
+    return size_ == 0;
+}
+
+template <typename Type>
+SimpleVectorView<Type> SimpleVectorView<Type>::Subview(size_t offset, size_t count) const {
+    if (offset > size_)
+        throw std::out_of_range("The offset value is out of range");
+    return SimpleVectorView(data_ + offset, std::min(count, size_ - offset));
+}
+
+template <typename Type>
+SimpleVectorView<Type> SimpleVectorView<Type>::First(size_t count) const noexcept {
+    return SimpleVectorView(data_, std::min(count, size_));
+}
+
+template <typename Type>
+SimpleVectorView<Type> SimpleVectorView<Type>::Last(size_t count) const noexcept {
+    count = std::min(count, size_);
+    return SimpleVectorView(data_ + (size_ - count), count);
+}
+
+template <typename Type>
+SimpleVector<SimpleVectorView<Type>> SimpleVectorView<Type>::Split(size_t parts) const {
+    assert(parts > 0);
+    parts = std::min(parts, size_);
+    SimpleVector<SimpleVectorView> result(Reserve(parts));
+    const size_t base = parts == 0 ? 0 : size_ / parts;
+    const size_t longer = parts == 0 ? 0 : size_ % parts;
+    Type* first = data_;
+    for (size_t part = 0; part < parts; ++part) {
+        const size_t count = base + (part < longer ? 1 : 0);
+        result.PushBack(SimpleVectorView(first, count));
+        first += count;
+    }
+    return result;
+}
+
+template <typename Type>
+Type& SimpleVectorView<Type>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return data_[index];
+}
+
+template <typename Type>
+Type& SimpleVectorView<Type>::At(size_t index) const {
+    if (!(index < size_))
+        throw std::out_of_range("The index value is out of range");
+    return data_[index];
+}
+
+template <typename Type>
+typename SimpleVectorView<Type>::Iterator SimpleVectorView<Type>::begin() const noexcept {
+    return data_;
+}
+
+template <typename Type>
+typename SimpleVectorView<Type>::Iterator SimpleVectorView<Type>::end() const noexcept {
+    return data_ + size_;
+}
+
+template <typename Type>
+typename SimpleVectorView<Type>::ConstIterator SimpleVectorView<Type>::cbegin() const noexcept {
+    return data_;
+}
+
+template <typename Type>
+typename SimpleVectorView<Type>::ConstIterator SimpleVectorView<Type>::cend() const noexcept {
+    return data_ + size_;
+}
@@ -0,0 +1,591 @@
+#pragma once
+
+#include <algorithm>
+#include "array_ptr.h"
+#include "growth_policy.h"
+#include "relocation.h"
+#include "simple_vector.h"
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+// Вектор с API SimpleVector, хранящий до N элементов во встроенном буфере.
+// Память в куче выделяется только при превышении вместимости N, дальше вместимость
+// растёт согласно GrowthPolicy (см. growth_policy.h)
+template <typename Type, size_t N, typename Allocator = MallocAllocator<Type>, typename GrowthPolicy = DoublingGrowth>
+class SmallSimpleVector {
+    static_assert(N > 0, "Inline capacity must be positive");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    using AllocatorType = Allocator;
+
+    SmallSimpleVector() noexcept = default;
+    explicit SmallSimpleVector(const Allocator& alloc) noexcept;
+    explicit SmallSimpleVector(size_t size, const Allocator& alloc = Allocator());
+    SmallSimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator());
+    SmallSimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator());
+    SmallSimpleVector(const SmallSimpleVector& other);
+    SmallSimpleVector(SmallSimpleVector&& other) noexcept(IsTriviallyRelocatableV<Type>
+        || std::is_nothrow_move_constructible_v<Type>);
+    SmallSimpleVector(ReserveProxyObj value, const Allocator& alloc = Allocator());
+
+    ~SmallSimpleVector();
+
+    // Возвращает копию аллокатора, из которого вектор получает память в куче
+    Allocator GetAllocator() const noexcept;
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept;
+
+    // Возвращает вместимость массива. Не бывает меньше N
+    size_t GetCapacity() const noexcept;
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept;
+
+    // Сообщает, хранятся ли элементы во встроенном буфере
+    bool IsInline() const noexcept;
+
+    // Разрушает элементы и обнуляет размер массива, не изменяя его вместимость
+    void Clear() noexcept;
+
+    // Изменяет вместимость массива, при условии, что новая вместимость больше, чем текущая.
+    // При первом превышении N элементы переносятся из встроенного буфера в кучу
+    void Reserve(size_t new_capacity);
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type.
+    // При нехватке места вместимость растёт согласно GrowthPolicy
+    void Resize(size_t new_size);
+
+    // Добавляет элемент в конец вектора
+    // При нехватке места вместимость вектора растёт согласно GrowthPolicy
+    void PushBack(const Type& item);
+
+    void PushBack(Type&& item);
+
+    // Создаёт элемент из аргументов args непосредственно в конце вектора.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args);
+
+    // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept;
+
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, const Type& value);
+
+    Iterator Insert(ConstIterator pos, Type&& value);
+
+    // Создаёт элемент из аргументов args непосредственно в позиции pos.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args);
+
+    // Удаляет элемент вектора в указанной позиции
+    Iterator Erase(ConstIterator pos);
+
+    // Обменивает значение с другим вектором.
+    // Элементы встроенных буферов переносятся поэлементно
+    void Swap(SmallSimpleVector& other) noexcept(IsTriviallyRelocatableV<Type>
+        || (std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_swappable_v<Type>));
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index);
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const;
+
+    // Возвращает итератор на начало массива
+    Iterator begin() noexcept;
+
+    // Возвращает итератор на элемент, следующий за последним
+    Iterator end() noexcept;
+
+    // Возвращает константный итератор на начало массива
+    ConstIterator begin() const noexcept;
+
+    // Возвращает итератор на элемент, следующий за последним
+    ConstIterator end() const noexcept;
+
+    // Возвращает константный итератор на начало массива
+    ConstIterator cbegin() const noexcept;
+
+    // Возвращает итератор на элемент, следующий за последним
+    ConstIterator cend() const noexcept;
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept;
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept;
+
+    SmallSimpleVector& operator=(const SmallSimpleVector& rhs);
+
+    SmallSimpleVector& operator=(SmallSimpleVector&& rhs) noexcept(IsTriviallyRelocatableV<Type>
+        || (std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_swappable_v<Type>));
+
+private:
+    ArrayPtr<Type, Allocator> heap_;
+    size_t size_ = 0;
+    size_t capacity_ = N;
+    alignas(Type) unsigned char inline_buffer_[N * sizeof(Type)];
+
+    // Возвращает адрес текущего хранилища: встроенного буфера либо памяти в куче
+    Type* Data() noexcept;
+
+    const Type* Data() const noexcept;
+
+    Type* InlineData() noexcept;
+
+    // Вместимость не меньше required, до которой вырастает вектор согласно GrowthPolicy
+    size_t GrowCapacity(size_t required) const noexcept;
+
+    // Сдвигает элементы [index, size) на одну позицию вправо. Требует, чтобы size < capacity
+    void ShiftRight(size_t index);
+
+    // Переносит элементы из встроенного буфера other во встроенный буфер этого вектора.
+    // Встроенный буфер этого вектора должен быть свободен
+    void TakeInline(SmallSimpleVector& other);
+
+    // Заменяет хранилище вектора памятью new_data, разрушая элементы старого хранилища,
+    // если они не были перенесены побайтово. Элементы уже должны быть перенесены
+    void ReplaceBuffer(ArrayPtr<Type, Allocator>& new_data) noexcept;
+};
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool operator==(const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool operator!=(const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool operator<(const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool operator<=(const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool operator>(const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool operator>=(const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& rhs) {
+    return !(lhs < rhs);
+}
+
+// -------------------SmallSimpleVector-------------------
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::SmallSimpleVector(const Allocator& alloc) noexcept
+    : heap_(alloc) {
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::SmallSimpleVector(size_t size, const Allocator& alloc)
+    : heap_(alloc) {
+    Reserve(size);
+    std::uninitialized_value_construct_n(Data(), size);
+    size_ = size;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::SmallSimpleVector(size_t size, const Type& value, const Allocator& alloc)
+    : heap_(alloc) {
+    Reserve(size);
+    std::uninitialized_fill_n(Data(), size, value);
+    size_ = size;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::SmallSimpleVector(std::initializer_list<Type> init, const Allocator& alloc)
+    : heap_(alloc) {
+    Reserve(init.size());
+    std::uninitialized_copy(init.begin(), init.end(), Data());
+    size_ = init.size();
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::SmallSimpleVector(const SmallSimpleVector& other)
+    : heap_(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.heap_.GetAllocator())) {
+    Reserve(other.size_);
+    std::uninitialized_copy(other.begin(), other.end(), Data());
+    size_ = other.size_;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::SmallSimpleVector(SmallSimpleVector&& other) noexcept(IsTriviallyRelocatableV<Type>
+    || std::is_nothrow_move_constructible_v<Type>)
+    : heap_(other.heap_.GetAllocator()) {
+    if (other.IsInline()) {
+        TakeInline(other);
+    }
+    else {
+        heap_.Swap(other.heap_);
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, N);
+    }
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::SmallSimpleVector(ReserveProxyObj value, const Allocator& alloc)
+    : heap_(alloc) {
+    Reserve(value.GetNewCapacity());
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::~SmallSimpleVector() {
+    std::destroy_n(Data(), size_);
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+Allocator SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::GetAllocator() const noexcept {
+    return heap_.GetAllocator();
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+size_t SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::GetSize() const noexcept {
+    return size_;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+size_t SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::GetCapacity() const noexcept {
+    return capacity_;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+bool SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::IsEmpty() const noexcept {
+    return size_ == 0;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+bool SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::IsInline() const noexcept {
+    return !heap_;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Clear() noexcept {
+    std::destroy_n(Data(), size_);
+    size_ = 0;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Reserve(size_t new_capacity) {
+    if (new_capacity <= capacity_) {
+        return;
+    }
+    if constexpr (IsTriviallyRelocatableV<Type>) {
+        if (!IsInline()) {
+            heap_.Reallocate(new_capacity);
+            capacity_ = new_capacity;
+            return;
+        }
+    }
+    ArrayPtr<Type, Allocator> new_data(new_capacity, heap_.GetAllocator());
+    UninitializedRelocate(Data(), size_, new_data.Get());
+    ReplaceBuffer(new_data);
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Resize(size_t new_size) {
+    if (new_size <= size_) {
+        std::destroy_n(Data() + new_size, size_ - new_size);
+        size_ = new_size;
+        return;
+    }
+    if (new_size > capacity_) {
+        Reserve(GrowCapacity(new_size));
+    }
+    std::uninitialized_value_construct(end(), begin() + new_size);
+    size_ = new_size;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::PushBack(const Type& item) {
+    EmplaceBack(item);
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::PushBack(Type&& item) {
+    EmplaceBack(std::move(item));
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+Type& SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::EmplaceBack(Args&&... args) {
+    if (size_ == capacity_) {
+        // Новый элемент создаётся до переноса старых, так как args могут ссылаться на элементы вектора
+        ArrayPtr<Type, Allocator> new_data(GrowCapacity(size_ + 1), heap_.GetAllocator());
+        new (new_data.Get() + size_) Type(std::forward<Args>(args)...);
+        try {
+            UninitializedRelocate(Data(), size_, new_data.Get());
+        } catch (...) {
+            new_data[size_].~Type();
+            throw;
+        }
+        ReplaceBuffer(new_data);
+    }
+    else {
+        new (end()) Type(std::forward<Args>(args)...);
+    }
+    ++size_;
+    return Data()[size_ - 1];
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::PopBack() noexcept {
+    assert(size_ != 0);
+    --size_;
+    Data()[size_].~Type();
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Iterator SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Insert(ConstIterator pos, const Type& value) {
+    return Emplace(pos, value);
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Iterator SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Insert(ConstIterator pos, Type&& value) {
+    return Emplace(pos, std::move(value));
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+typename SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Iterator SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Emplace(ConstIterator pos, Args&&... args) {
+    assert(begin() <= pos && pos <= end());
+    const size_t delta = pos - cbegin();
+    if (delta == size_) {
+        EmplaceBack(std::forward<Args>(args)...);
+        return begin() + delta;
+    }
+    if (size_ == capacity_) {
+        ArrayPtr<Type, Allocator> new_data(GrowCapacity(size_ + 1), heap_.GetAllocator());
+        new (new_data.Get() + delta) Type(std::forward<Args>(args)...);
+        try {
+            UninitializedRelocate(Data(), delta, new_data.Get());
+            try {
+                UninitializedRelocate(Data() + delta, size_ - delta, new_data.Get() + delta + 1);
+            } catch (...) {
+                std::destroy_n(new_data.Get(), delta);
+                throw;
+            }
+        } catch (...) {
+            new_data[delta].~Type();
+            throw;
+        }
+        ReplaceBuffer(new_data);
+    }
+    else if constexpr (IsTriviallyRelocatableV<Type>) {
+        alignas(Type) unsigned char temp[sizeof(Type)];
+        new (temp) Type(std::forward<Args>(args)...);
+        ShiftRight(delta);
+        RelocateBytes(reinterpret_cast<Type*>(temp), 1, Data() + delta);
+    }
+    else {
+        Type temp(std::forward<Args>(args)...);
+        ShiftRight(delta);
+        Data()[delta] = std::move(temp);
+    }
+    ++size_;
+    return begin() + delta;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Iterator SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Erase(ConstIterator pos) {
+    assert(begin() <= pos && pos < end());
+    const auto it = begin() + (pos - cbegin());
+    if constexpr (IsTriviallyRelocatableV<Type>) {
+        it->~Type();
+        ShiftBytes(it + 1, end() - it - 1, it);
+        --size_;
+    }
+    else {
+        std::move(it + 1, end(), it);
+        PopBack();
+    }
+    return it;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Swap(SmallSimpleVector& other) noexcept(IsTriviallyRelocatableV<Type>
+    || (std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_swappable_v<Type>)) {
+    if (this == &other) {
+        return;
+    }
+    if (!IsInline() && !other.IsInline()) {
+        heap_.Swap(other.heap_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        return;
+    }
+    if (IsInline() && other.IsInline()) {
+        SmallSimpleVector& shorter = size_ < other.size_ ? *this : other;
+        SmallSimpleVector& longer = size_ < other.size_ ? other : *this;
+        std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+        const size_t common = shorter.size_;
+        const size_t tail = longer.size_ - common;
+        UninitializedRelocate(longer.Data() + common, tail, shorter.Data() + common);
+        if constexpr (!IsTriviallyRelocatableV<Type>) {
+            std::destroy_n(longer.Data() + common, tail);
+        }
+        std::swap(size_, other.size_);
+        return;
+    }
+    // Один вектор хранит элементы в куче, другой во встроенном буфере
+    SmallSimpleVector& heap_owner = IsInline() ? other : *this;
+    SmallSimpleVector& inline_owner = IsInline() ? *this : other;
+    const size_t inline_size = inline_owner.size_;
+    UninitializedRelocate(inline_owner.InlineData(), inline_size, heap_owner.InlineData());
+    if constexpr (!IsTriviallyRelocatableV<Type>) {
+        std::destroy_n(inline_owner.InlineData(), inline_size);
+    }
+    inline_owner.heap_.Swap(heap_owner.heap_);
+    inline_owner.size_ = heap_owner.size_;
+    inline_owner.capacity_ = heap_owner.capacity_;
+    heap_owner.size_ = inline_size;
+    heap_owner.capacity_ = N;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+Type& SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::At(size_t index) {
+    if (!(index < size_))
+        throw std::out_of_range("The index value is out of range");
+    return Data()[index];
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+const Type& SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::At(size_t index) const {
+    if (!(index < size_))
+        throw std::out_of_range("The index value is out of range");
+    return Data()[index];
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+Type& SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return Data()[index];
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+const Type& SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return Data()[index];
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::operator=(const SmallSimpleVector& rhs) {
+    if (this != &rhs) {
+        SmallSimpleVector temp(rhs);
+        Swap(temp);
+    }
+    return *this;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::operator=(SmallSimpleVector&& rhs) noexcept(IsTriviallyRelocatableV<Type>
+    || (std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_swappable_v<Type>)) {
+    if (this != &rhs) {
+        SmallSimpleVector temp(std::move(rhs));
+        Swap(temp);
+    }
+    return *this;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Iterator SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::begin() noexcept {
+    return Data();
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Iterator SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::end() noexcept {
+    return Data() + size_;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::ConstIterator SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::begin() const noexcept {
+    return Data();
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::ConstIterator SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::end() const noexcept {
+    return Data() + size_;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::ConstIterator SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::cbegin() const noexcept {
+    return Data();
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+typename SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::ConstIterator SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::cend() const noexcept {
+    return Data() + size_;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+Type* SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Data() noexcept {
+    return IsInline() ? InlineData() : heap_.Get();
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+const Type* SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::Data() const noexcept {
+    return IsInline() ? std::launder(reinterpret_cast<const Type*>(inline_buffer_)) : heap_.Get();
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+Type* SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::InlineData() noexcept {
+    return std::launder(reinterpret_cast<Type*>(inline_buffer_));
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+size_t SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::GrowCapacity(size_t required) const noexcept {
+    return GrowthPolicy::NextCapacity(capacity_, required, sizeof(Type));
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::ShiftRight(size_t index) {
+    assert(size_ < capacity_ && index < size_);
+    Type* data = Data();
+    if constexpr (IsTriviallyRelocatableV<Type>) {
+        ShiftBytes(data + index, size_ - index, data + index + 1);
+    }
+    else {
+        new (data + size_) Type(std::move(data[size_ - 1]));
+        std::move_backward(data + index, data + size_ - 1, data + size_);
+    }
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::TakeInline(SmallSimpleVector& other) {
+    assert(IsInline() && size_ == 0 && other.IsInline());
+    UninitializedRelocate(other.InlineData(), other.size_, InlineData());
+    if constexpr (!IsTriviallyRelocatableV<Type>) {
+        std::destroy_n(other.InlineData(), other.size_);
+    }
+    size_ = std::exchange(other.size_, 0);
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+void SmallSimpleVector<Type, N, Allocator, GrowthPolicy>::ReplaceBuffer(ArrayPtr<Type, Allocator>& new_data) noexcept {
+    if constexpr (!IsTriviallyRelocatableV<Type>) {
+        std::destroy_n(Data(), size_);
+    }
+    heap_.Swap(new_data);
+    capacity_ = heap_.GetSize();
+}
@@ -0,0 +1,912 @@
+#pragma once
+
+#include "allocator.h"
+#include "array_ptr.h"
+#include "growth_policy.h"
+#include "instrumentation.h"
+#include "relocation.h"
+#include "simple_vector_view.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace soa_detail {
+
+// Вызывает action(std::integral_constant<size_t, I>()) для каждого I по порядку
+template <typename Action, size_t... I>
+void ForEachIndex(Action&& action, std::index_sequence<I...>) {
+    (action(std::integral_constant<size_t, I>()), ...);
+}
+
+} // namespace soa_detail
+
+// Ссылка на строку SoaSimpleVector: набор ссылок на поля с одним индексом в массивах
+// отдельных полей. Копирование ссылки не копирует значения, а присваивание ссылке
+// записывает значения полей в строку вектора, как у std::vector<bool>::reference.
+// Ссылку можно разобрать структурной привязкой, получив ссылки на поля:
+//
+//     for (auto [id, price] : soa) {
+//         price *= 2;
+//     }
+//
+// Ссылка действительна, пока вектор не перевыделил буферы и строка не удалена
+template <bool IsConst, typename... Fields>
+class SoaRowRef {
+public:
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    template <size_t I>
+    using FieldReference = std::conditional_t<IsConst, const FieldType<I>&, FieldType<I>&>;
+
+    using Pointers = std::tuple<std::conditional_t<IsConst, const Fields*, Fields*>...>;
+
+    explicit SoaRowRef(const Pointers& fields) noexcept;
+
+    SoaRowRef(const SoaRowRef&) noexcept = default;
+
+    // Ссылка на изменяемую строку преобразуется в ссылку на константную
+    template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    SoaRowRef(const SoaRowRef<OtherConst, Fields...>& other) noexcept;
+
+    // Записывает в строку значения полей строки other
+    const SoaRowRef& operator=(const SoaRowRef& other) const;
+
+    template <bool OtherConst>
+    const SoaRowRef& operator=(const SoaRowRef<OtherConst, Fields...>& other) const;
+
+    // Записывает в строку значения полей из values
+    const SoaRowRef& operator=(const std::tuple<Fields...>& values) const;
+
+    const SoaRowRef& operator=(std::tuple<Fields...>&& values) const;
+
+    // Возвращает ссылку на поле I строки
+    template <size_t I>
+    FieldReference<I> Get() const noexcept;
+
+    // Копирует значения полей строки
+    operator std::tuple<Fields...>() const;
+
+private:
+    template <bool OtherConst, typename... Others>
+    friend class SoaRowRef;
+
+    Pointers fields_;
+
+    template <typename Values, size_t... I>
+    void Assign(Values&& values, std::index_sequence<I...>) const;
+};
+
+// Обменивает значения полей двух строк
+template <typename... Fields>
+void swap(SoaRowRef<false, Fields...> lhs, SoaRowRef<false, Fields...> rhs) noexcept;
+
+// Доступ к полям строки для структурной привязки
+template <size_t I, bool IsConst, typename... Fields>
+typename SoaRowRef<IsConst, Fields...>::template FieldReference<I> get(const SoaRowRef<IsConst, Fields...>& row) noexcept;
+
+template <bool IsConst, typename... Fields>
+struct std::tuple_size<SoaRowRef<IsConst, Fields...>> : std::integral_constant<size_t, sizeof...(Fields)> {};
+
+template <size_t I, bool IsConst, typename... Fields>
+struct std::tuple_element<I, SoaRowRef<IsConst, Fields...>> {
+    using type = typename SoaRowRef<IsConst, Fields...>::template FieldReference<I>;
+};
+
+// Вектор в виде структуры массивов (structure of arrays): каждое поле записи хранится
+// в отдельном непрерывном массиве, и все массивы растут вместе по правилам SimpleVector.
+// Цикл, читающий одно-два поля, загружает в кеш только их, а не записи целиком, и
+// векторизуется по представлению поля GetField<I>(). Код, работающий с записями,
+// обращается к строкам через ссылки SoaRowRef, которые возвращают operator[] и итераторы.
+// Массивы полей выровнены по границе кеш-линии. Рост выбирает DoublingGrowth по
+// суммарному размеру полей строки.
+// Поля должны перемещаться без исключений: тогда перенос строк между буферами и сдвиг
+// при вставке и удалении не могут прерваться на середине, оставив массивы полей
+// разной длины. Вставка, выбросившая исключение при создании полей, не изменяет вектор
+template <typename... Fields>
+class SoaSimpleVector {
+    static_assert(sizeof...(Fields) > 0, "SoaSimpleVector needs at least one field");
+    static_assert((std::is_nothrow_move_constructible_v<Fields> && ...) && (std::is_nothrow_move_assignable_v<Fields> && ...),
+                  "SoaSimpleVector fields must be nothrow movable");
+
+public:
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    using Row = SoaRowRef<false, Fields...>;
+    using ConstRow = SoaRowRef<true, Fields...>;
+
+    template <bool IsConst>
+    class BasicIterator;
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    // Количество полей в строке
+    static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+
+    SoaSimpleVector() noexcept = default;
+
+    // Создаёт вектор из size строк, поля которых инициализированы значениями по умолчанию
+    explicit SoaSimpleVector(size_t size);
+
+    SoaSimpleVector(const SoaSimpleVector& other);
+    SoaSimpleVector(SoaSimpleVector&& other) noexcept;
+
+    SoaSimpleVector& operator=(const SoaSimpleVector& rhs);
+    SoaSimpleVector& operator=(SoaSimpleVector&& rhs) noexcept;
+
+    ~SoaSimpleVector();
+
+    size_t GetSize() const noexcept;
+    size_t GetCapacity() const noexcept;
+    bool IsEmpty() const noexcept;
+
+    // Представление массива поля I для просмотра и изменения значений этого поля во всех
+    // строках. Действительно, пока вектор не перевыделил буферы
+    template <size_t I>
+    SimpleVectorView<FieldType<I>> GetField() noexcept;
+
+    template <size_t I>
+    SimpleVectorView<const FieldType<I>> GetField() const noexcept;
+
+    // Удаляет все строки, вместимость сохраняется
+    void Clear() noexcept;
+
+    // Увеличивает вместимость массивов всех полей до new_capacity строк
+    void Reserve(size_t new_capacity);
+
+    // Уменьшает вместимость до размера вектора
+    void ShrinkToFit();
+
+    // Изменяет количество строк. Новые строки инициализируются значениями по умолчанию
+    void Resize(size_t new_size);
+
+    // Добавляет строку со значениями полей values в конец вектора
+    void PushBack(const Fields&... values);
+
+    void PushBack(Fields&&... values);
+
+    // Создаёт поля новой строки в конце вектора, по одному аргументу на поле,
+    // и возвращает ссылку на строку
+    template <typename... Args>
+    Row EmplaceBack(Args&&... args);
+
+    // Удаляет последнюю строку. Вектор не должен быть пустым
+    void PopBack() noexcept;
+
+    // Вставляет строку перед pos и возвращает итератор на неё
+    Iterator Insert(ConstIterator pos, const Fields&... values);
+
+    Iterator Insert(ConstIterator pos, Fields&&... values);
+
+    // Вставляет count одинаковых строк перед pos и возвращает итератор на первую из них
+    Iterator Insert(ConstIterator pos, size_t count, const Fields&... values);
+
+    // Создаёт поля новой строки перед pos, по одному аргументу на поле
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args);
+
+    // Удаляет строку в позиции pos и возвращает итератор на следующую
+    Iterator Erase(ConstIterator pos) noexcept;
+
+    // Удаляет строки [first, last) и возвращает итератор на строку, следовавшую за ними
+    Iterator Erase(ConstIterator first, ConstIterator last) noexcept;
+
+    void Swap(SoaSimpleVector& other) noexcept;
+
+    Row operator[](size_t index) noexcept;
+    ConstRow operator[](size_t index) const noexcept;
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Row At(size_t index);
+    ConstRow At(size_t index) const;
+
+    Iterator begin() noexcept;
+    Iterator end() noexcept;
+    ConstIterator begin() const noexcept;
+    ConstIterator end() const noexcept;
+    ConstIterator cbegin() const noexcept;
+    ConstIterator cend() const noexcept;
+
+private:
+    template <typename Field>
+    using FieldBuffer = ArrayPtr<Field, AlignedAllocator<Field, CACHE_LINE_ALIGNMENT>>;
+
+    using Buffers = std::tuple<FieldBuffer<Fields>...>;
+    using Pointers = std::tuple<Fields*...>;
+
+    template <size_t I>
+    using FieldIndex = std::integral_constant<size_t, I>;
+
+    // Суммарный размер полей строки, по которому GrowthPolicy выбирает вместимость
+    static constexpr size_t ROW_SIZE = (sizeof(Fields) + ...);
+
+    Buffers fields_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+
+    // Выделяет буферы всех полей под capacity строк
+    static Buffers AllocateBuffers(size_t capacity);
+
+    // Указатели на строку index в буферах buffers
+    static Pointers RowPointers(const Buffers& buffers, size_t index) noexcept;
+
+    // Вызывает action(FieldIndex<I>()) для каждого поля
+    template <typename Action>
+    static void ForEachField(Action&& action);
+
+    // Вызывает construct(FieldIndex<I>()) для каждого поля по порядку. Если поле
+    // выбросило исключение, для уже созданных полей в обратном порядке вызывается undo
+    template <size_t I = 0, typename Construct, typename Undo>
+    static void ConstructEachField(Construct& construct, Undo& undo);
+
+    // Создаёт поля строки dest из элементов кортежа args, по одному на поле
+    template <typename ArgTuple>
+    static void ConstructRow(const Pointers& dest, ArgTuple&& args);
+
+    size_t GrowCapacity(size_t required) const noexcept;
+
+    // Переносит строки в новые буферы вместимостью new_capacity
+    void Reallocate(size_t new_capacity);
+
+    // Вставляет count строк перед строкой index. fill(dest) создаёт строки [dest, dest + count)
+    // в массивах полей, а при исключении разрушает то, что успела создать
+    template <typename Fill>
+    Iterator InsertRows(size_t index, size_t count, Fill fill);
+
+    // Разрушает строки [first, size_)
+    void DestroyTail(size_t first) noexcept;
+};
+
+template <typename... Fields>
+bool operator==(const SoaSimpleVector<Fields...>& lhs, const SoaSimpleVector<Fields...>& rhs);
+
+template <typename... Fields>
+bool operator!=(const SoaSimpleVector<Fields...>& lhs, const SoaSimpleVector<Fields...>& rhs);
+
+// Итератор произвольного доступа по индексу строки. Разыменование возвращает ссылку
+// на строку SoaRowRef по значению, поэтому operator-> отсутствует
+template <typename... Fields>
+template <bool IsConst>
+class SoaSimpleVector<Fields...>::BasicIterator {
+    using Vector = std::conditional_t<IsConst, const SoaSimpleVector, SoaSimpleVector>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::tuple<Fields...>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = SoaRowRef<IsConst, Fields...>;
+
+    BasicIterator() noexcept = default;
+
+    // Итератор преобразуется в константный
+    template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+        : vector_(other.vector_), index_(other.index_) {
+    }
+
+    reference operator*() const noexcept {
+        return (*vector_)[index_];
+    }
+
+    reference operator[](difference_type offset) const noexcept {
+        return (*vector_)[index_ + offset];
+    }
+
+    BasicIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+        BasicIterator result = *this;
+        ++index_;
+        return result;
+    }
+
+    BasicIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    BasicIterator operator--(int) noexcept {
+        BasicIterator result = *this;
+        --index_;
+        return result;
+    }
+
+    BasicIterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+
+    BasicIterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+
+    friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+
+    friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+        return it += offset;
+    }
+
+    friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+
+    friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+private:
+    friend class SoaSimpleVector;
+
+    template <bool OtherConst>
+    friend class BasicIterator;
+
+    Vector* vector_ = nullptr;
+    size_t index_ = 0;
+
+    BasicIterator(Vector* vector, size_t index) noexcept
+        : vector_(vector), index_(index) {
+    }
+};
+
+// ---------------------SoaRowRef---------------------
+
+template <bool IsConst, typename... Fields>
+SoaRowRef<IsConst, Fields...>::SoaRowRef(const Pointers& fields) noexcept
+    : fields_(fields) {
+}
+
+template <bool IsConst, typename... Fields>
+template <bool OtherConst, typename>
+SoaRowRef<IsConst, Fields...>::SoaRowRef(const SoaRowRef<OtherConst, Fields...>& other) noexcept
+    : fields_(other.fields_) {
+}
+
+template <bool IsConst, typename... Fields>
+const SoaRowRef<IsConst, Fields...>& SoaRowRef<IsConst, Fields...>::operator=(const SoaRowRef& other) const {
+    return *this = static_cast<std::tuple<Fields...>>(other);
+}
+
+template <bool IsConst, typename... Fields>
+template <bool OtherConst>
+const SoaRowRef<IsConst, Fields...>& SoaRowRef<IsConst, Fields...>::operator=(const SoaRowRef<OtherConst, Fields...>& other) const {
+    // Значения копируются во временный кортеж: строки могут совпадать
+    return *this = static_cast<std::tuple<Fields...>>(other);
+}
+
+template <bool IsConst, typename... Fields>
+const SoaRowRef<IsConst, Fields...>& SoaRowRef<IsConst, Fields...>::operator=(const std::tuple<Fields...>& values) const {
+    static_assert(!IsConst, "Cannot assign through a reference to a const row");
+    Assign(values, std::index_sequence_for<Fields...>());
+    return *this;
+}
+
+template <bool IsConst, typename... Fields>
+const SoaRowRef<IsConst, Fields...>& SoaRowRef<IsConst, Fields...>::operator=(std::tuple<Fields...>&& values) const {
+    static_assert(!IsConst, "Cannot assign through a reference to a const row");
+    Assign(std::move(values), std::index_sequence_for<Fields...>());
+    return *this;
+}
+
+template <bool IsConst, typename... Fields>
+template <size_t I>
+typename SoaRowRef<IsConst, Fields...>::template FieldReference<I> SoaRowRef<IsConst, Fields...>::Get() const noexcept {
+    return *std::get<I>(fields_);
+}
+
+template <bool IsConst, typename... Fields>
+SoaRowRef<IsConst, Fields...>::operator std::tuple<Fields...>() const {
+    return std::apply([](const auto*... fields) {
+        return std::tuple<Fields...>(*fields...);
+    }, fields_);
+}
+
+template <bool IsConst, typename... Fields>
+template <typename Values, size_t... I>
+void SoaRowRef<IsConst, Fields...>::Assign(Values&& values, std::index_sequence<I...>) const {
+    ((*std::get<I>(fields_) = std::get<I>(std::forward<Values>(values))), ...);
+}
+
+template <typename... Fields>
+void swap(SoaRowRef<false, Fields...> lhs, SoaRowRef<false, Fields...> rhs) noexcept {
+    soa_detail::ForEachIndex([&lhs, &rhs](auto field) {
+        constexpr size_t I = decltype(field)::value;
+        using std::swap;
+        swap(lhs.template Get<I>(), rhs.template Get<I>());
+    }, std::index_sequence_for<Fields...>());
+}
+
+template <size_t I, bool IsConst, typename... Fields>
+typename SoaRowRef<IsConst, Fields...>::template FieldReference<I> get(const SoaRowRef<IsConst, Fields...>& row) noexcept {
+    return row.template Get<I>();
+}
+
+// ------------------SoaSimpleVector------------------
+
+template <typename... Fields>
+SoaSimpleVector<Fields...>::SoaSimpleVector(size_t size) {
+    Resize(size);
+}
+
+template <typename... Fields>
+SoaSimpleVector<Fields...>::SoaSimpleVector(const SoaSimpleVector& other)
+    : fields_(AllocateBuffers(other.size_)), capacity_(other.size_) {
+    auto copy = [this, &other](auto field) {
+        constexpr size_t I = decltype(field)::value;
+        UninitializedCopyN(std::get<I>(other.fields_).Get(), size_, std::get<I>(fields_).Get());
+    };
+    auto undo = [this](auto field) {
+        std::destroy_n(std::get<decltype(field)::value>(fields_).Get(), size_);
+    };
+    size_ = other.size_;
+    try {
+        ConstructEachField(copy, undo);
+    } catch (...) {
+        size_ = 0;
+        throw;
+    }
+}
+
+template <typename... Fields>
+SoaSimpleVector<Fields...>::SoaSimpleVector(SoaSimpleVector&& other) noexcept
+    : fields_(std::move(other.fields_))
+    , size_(std::exchange(other.size_, 0))
+    , capacity_(std::exchange(other.capacity_, 0)) {
+}
+
+template <typename... Fields>
+SoaSimpleVector<Fields...>& SoaSimpleVector<Fields...>::operator=(const SoaSimpleVector& rhs) {
+    if (this != &rhs) {
+        SoaSimpleVector copy(rhs);
+        Swap(copy);
+    }
+    return *this;
+}
+
+template <typename... Fields>
+SoaSimpleVector<Fields...>& SoaSimpleVector<Fields...>::operator=(SoaSimpleVector&& rhs) noexcept {
+    if (this != &rhs) {
+        Clear();
+        fields_ = std::move(rhs.fields_);
+        size_ = std::exchange(rhs.size_, 0);
+        capacity_ = std::exchange(rhs.capacity_, 0);
+    }
+    return *this;
+}
+
+template <typename... Fields>
+SoaSimpleVector<Fields...>::~SoaSimpleVector() {
+    Clear();
+}
+
+template <typename... Fields>
+size_t SoaSimpleVector<Fields...>::GetSize() const noexcept {
+    return size_;
+}
+
+template <typename... Fields>
+size_t SoaSimpleVector<Fields...>::GetCapacity() const noexcept {
+    return capacity_;
+}
+
+template <typename... Fields>
+bool SoaSimpleVector<Fields...>::IsEmpty() const noexcept {
+    return size_ == 0;
+}
+
+template <typename... Fields>
+template <size_t I>
+SimpleVectorView<typename SoaSimpleVector<Fields...>::template FieldType<I>> SoaSimpleVector<Fields...>::GetField() noexcept {
+    return SimpleVectorView<FieldType<I>>(std::get<I>(fields_).Get(), size_);
+}
+
+template <typename... Fields>
+template <size_t I>
+SimpleVectorView<const typename SoaSimpleVector<Fields...>::template FieldType<I>> SoaSimpleVector<Fields...>::GetField() const noexcept {
+    return SimpleVectorView<const FieldType<I>>(std::get<I>(fields_).Get(), size_);
+}
+
+template <typename... Fields>
+void SoaSimpleVector<Fields...>::Clear() noexcept {
+    DestroyTail(0);
+}
+
+template <typename... Fields>
+void SoaSimpleVector<Fields...>::Reserve(size_t new_capacity) {
+    if (new_capacity > capacity_) {
+        Reallocate(new_capacity);
+    }
+}
+
+template <typename... Fields>
+void SoaSimpleVector<Fields...>::ShrinkToFit() {
+    if (capacity_ > size_) {
+        Reallocate(size_);
+    }
+}
+
+template <typename... Fields>
+void SoaSimpleVector<Fields...>::Resize(size_t new_size) {
+    if (new_size <= size_) {
+        DestroyTail(new_size);
+        return;
+    }
+    if (new_size > capacity_) {
+        Reallocate(GrowCapacity(new_size));
+    }
+    auto construct = [this, new_size](auto field) {
+        auto* data = std::get<decltype(field)::value>(fields_).Get();
+        UninitializedValueConstruct(data + size_, data + new_size);
+    };
+    auto undo = [this, new_size](auto field) {
+        std::destroy_n(std::get<decltype(field)::value>(fields_).Get() + size_, new_size - size_);
+    };
+    ConstructEachField(construct, undo);
+    size_ = new_size;
+}
+
+template <typename... Fields>
+void SoaSimpleVector<Fields...>::PushBack(const Fields&... values) {
+    EmplaceBack(values...);
+}
+
+template <typename... Fields>
+void SoaSimpleVector<Fields...>::PushBack(Fields&&... values) {
+    EmplaceBack(std::move(values)...);
+}
+
+template <typename... Fields>
+template <typename... Args>
+typename SoaSimpleVector<Fields...>::Row SoaSimpleVector<Fields...>::EmplaceBack(Args&&... args) {
+    static_assert(sizeof...(Args) == FIELD_COUNT, "EmplaceBack takes one argument per field");
+    // В конец строка создаётся без сдвига, а при росте — в новых буферах до переноса
+    // старых строк, поэтому args могут ссылаться на поля вектора
+    InsertRows(size_, 1, [&args...](const Pointers& dest) {
+        ConstructRow(dest, std::forward_as_tuple(std::forward<Args>(args)...));
+    });
+    return (*this)[size_ - 1];
+}
+
+template <typename... Fields>
+void SoaSimpleVector<Fields...>::PopBack() noexcept {
+    assert(size_ != 0);
+    DestroyTail(size_ - 1);
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::Iterator SoaSimpleVector<Fields...>::Insert(ConstIterator pos, const Fields&... values) {
+    return Emplace(pos, values...);
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::Iterator SoaSimpleVector<Fields...>::Insert(ConstIterator pos, Fields&&... values) {
+    return Emplace(pos, std::move(values)...);
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::Iterator SoaSimpleVector<Fields...>::Insert(ConstIterator pos, size_t count, const Fields&... values) {
+    assert(cbegin() <= pos && pos <= cend());
+    // values могут ссылаться на поля вектора, которые сместятся при сдвиге хвоста
+    const std::tuple<Fields...> row(values...);
+    return InsertRows(pos - cbegin(), count, [&row, count](const Pointers& dest) {
+        auto fill = [&row, &dest, count](auto field) {
+            constexpr size_t I = decltype(field)::value;
+            UninitializedFillN(std::get<I>(dest), count, std::get<I>(row));
+        };
+        auto undo = [&dest, count](auto field) {
+            std::destroy_n(std::get<decltype(field)::value>(dest), count);
+        };
+        ConstructEachField(fill, undo);
+    });
+}
+
+template <typename... Fields>
+template <typename... Args>
+typename SoaSimpleVector<Fields...>::Iterator SoaSimpleVector<Fields...>::Emplace(ConstIterator pos, Args&&... args) {
+    static_assert(sizeof...(Args) == FIELD_COUNT, "Emplace takes one argument per field");
+    assert(cbegin() <= pos && pos <= cend());
+    const size_t index = pos - cbegin();
+    if (index == size_ || size_ == capacity_) {
+        return InsertRows(index, 1, [&args...](const Pointers& dest) {
+            ConstructRow(dest, std::forward_as_tuple(std::forward<Args>(args)...));
+        });
+    }
+    // args могут ссылаться на поля вектора, поэтому строка создаётся до сдвига
+    std::tuple<Fields...> row(std::forward<Args>(args)...);
+    return InsertRows(index, 1, [&row](const Pointers& dest) {
+        ConstructRow(dest, std::move(row));
+    });
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::Iterator SoaSimpleVector<Fields...>::Erase(ConstIterator pos) noexcept {
+    assert(cbegin() <= pos && pos < cend());
+    return Erase(pos, pos + 1);
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::Iterator SoaSimpleVector<Fields...>::Erase(ConstIterator first, ConstIterator last) noexcept {
+    assert(cbegin() <= first && first <= last && last <= cend());
+    const size_t index = first - cbegin();
+    const size_t count = last - first;
+    if (count == 0) {
+        return begin() + index;
+    }
+    ForEachField([this, index, count](auto field) {
+        using Field = FieldType<decltype(field)::value>;
+        Field* data = std::get<decltype(field)::value>(fields_).Get();
+        instrumentation::OnShift<Field>(size_ - index - count);
+        if constexpr (IsTriviallyRelocatableV<Field>) {
+            std::destroy_n(data + index, count);
+            ShiftBytes(data + index + count, size_ - index - count, data + index);
+        }
+        else {
+            std::move(data + index + count, data + size_, data + index);
+            std::destroy_n(data + size_ - count, count);
+        }
+    });
+    size_ -= count;
+    return begin() + index;
+}
+
+template <typename... Fields>
+void SoaSimpleVector<Fields...>::Swap(SoaSimpleVector& other) noexcept {
+    std::swap(fields_, other.fields_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::Row SoaSimpleVector<Fields...>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return Row(RowPointers(fields_, index));
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::ConstRow SoaSimpleVector<Fields...>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return ConstRow(RowPointers(fields_, index));
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::Row SoaSimpleVector<Fields...>::At(size_t index) {
+    if (!(index < size_))
+        throw std::out_of_range("The index value is out of range");
+    return (*this)[index];
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::ConstRow SoaSimpleVector<Fields...>::At(size_t index) const {
+    if (!(index < size_))
+        throw std::out_of_range("The index value is out of range");
+    return (*this)[index];
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::Iterator SoaSimpleVector<Fields...>::begin() noexcept {
+    return Iterator(this, 0);
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::Iterator SoaSimpleVector<Fields...>::end() noexcept {
+    return Iterator(this, size_);
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::ConstIterator SoaSimpleVector<Fields...>::begin() const noexcept {
+    return ConstIterator(this, 0);
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::ConstIterator SoaSimpleVector<Fields...>::end() const noexcept {
+    return ConstIterator(this, size_);
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::ConstIterator SoaSimpleVector<Fields...>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::ConstIterator SoaSimpleVector<Fields...>::cend() const noexcept {
+    return end();
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::Buffers SoaSimpleVector<Fields...>::AllocateBuffers(size_t capacity) {
+    // Буферы создаются по одному: если выделение прервётся, уже выделенные освободятся
+    return Buffers(FieldBuffer<Fields>(capacity)...);
+}
+
+template <typename... Fields>
+typename SoaSimpleVector<Fields...>::Pointers SoaSimpleVector<Fields...>::RowPointers(const Buffers& buffers, size_t index) noexcept {
+    return std::apply([index](const auto&... buffer) {
+        return Pointers(buffer.Get() + index...);
+    }, buffers);
+}
+
+template <typename... Fields>
+template <typename Action>
+void SoaSimpleVector<Fields...>::ForEachField(Action&& action) {
+    soa_detail::ForEachIndex(std::forward<Action>(action), std::index_sequence_for<Fields...>());
+}
+
+template <typename... Fields>
+template <size_t I, typename Construct, typename Undo>
+void SoaSimpleVector<Fields...>::ConstructEachField(Construct& construct, Undo& undo) {
+    if constexpr (I < FIELD_COUNT) {
+        construct(FieldIndex<I>());
+        try {
+            ConstructEachField<I + 1>(construct, undo);
+        } catch (...) {
+            undo(FieldIndex<I>());
+            throw;
+        }
+    }
+}
+
+template <typename... Fields>
+template <typename ArgTuple>
+void SoaSimpleVector<Fields...>::ConstructRow(const Pointers& dest, ArgTuple&& args) {
+    auto construct = [&dest, &args](auto field) {
+        constexpr size_t I = decltype(field)::value;
+        ConstructAt(std::get<I>(dest), std::get<I>(std::forward<ArgTuple>(args)));
+    };
+    auto undo = [&dest](auto field) {
+        std::destroy_at(std::get<decltype(field)::value>(dest));
+    };
+    ConstructEachField(construct, undo);
+}
+
+template <typename... Fields>
+size_t SoaSimpleVector<Fields...>::GrowCapacity(size_t required) const noexcept {
+    return DoublingGrowth::NextCapacity(capacity_, required, ROW_SIZE);
+}
+
+template <typename... Fields>
+void SoaSimpleVector<Fields...>::Reallocate(size_t new_capacity) {
+    assert(new_capacity >= size_);
+    Buffers new_fields = AllocateBuffers(new_capacity);
+    ForEachField([this, &new_fields](auto field) {
+        constexpr size_t I = decltype(field)::value;
+        using Field = FieldType<I>;
+        Field* data = std::get<I>(fields_).Get();
+        UninitializedRelocate(data, size_, std::get<I>(new_fields).Get());
+        if constexpr (!IsTriviallyRelocatableV<Field>) {
+            std::destroy_n(data, size_);
+        }
+        instrumentation::OnReallocate<Field>(size_);
+    });
+    fields_.swap(new_fields);
+    capacity_ = new_capacity;
+}
+
+template <typename... Fields>
+template <typename Fill>
+typename SoaSimpleVector<Fields...>::Iterator SoaSimpleVector<Fields...>::InsertRows(size_t index, size_t count, Fill fill) {
+    assert(index <= size_);
+    if (count == 0) {
+        return begin() + index;
+    }
+    if (count > capacity_ - size_) {
+        const size_t new_capacity = GrowCapacity(size_ + count);
+        Buffers new_fields = AllocateBuffers(new_capacity);
+        fill(RowPointers(new_fields, index));
+        // Поля перемещаются без исключений, поэтому после создания новых строк
+        // перенос старых уже не прервётся
+        ForEachField([this, &new_fields, index, count](auto field) {
+            constexpr size_t I = decltype(field)::value;
+            using Field = FieldType<I>;
+            Field* data = std::get<I>(fields_).Get();
+            Field* new_data = std::get<I>(new_fields).Get();
+            UninitializedRelocate(data, index, new_data);
+            UninitializedRelocate(data + index, size_ - index, new_data + index + count);
+            if constexpr (!IsTriviallyRelocatableV<Field>) {
+                std::destroy_n(data, size_);
+            }
+            instrumentation::OnReallocate<Field>(size_);
+        });
+        fields_.swap(new_fields);
+        capacity_ = new_capacity;
+    }
+    else {
+        auto shift = [this, index](size_t from, size_t to) {
+            ForEachField([this, index, from, to](auto field) {
+                using Field = FieldType<decltype(field)::value>;
+                Field* data = std::get<decltype(field)::value>(fields_).Get();
+                instrumentation::OnShift<Field>(size_ - index);
+                if constexpr (IsTriviallyRelocatableV<Field>) {
+                    ShiftBytes(data + from, size_ - index, data + to);
+                }
+                else if (from > to) {
+                    for (size_t i = 0; i < size_ - index; ++i) {
+                        ConstructAt(data + to + i, std::move(data[from + i]));
+                        std::destroy_at(data + from + i);
+                    }
+                }
+                else {
+                    for (size_t i = size_ - index; i > 0; --i) {
+                        ConstructAt(data + to + i - 1, std::move(data[from + i - 1]));
+                        std::destroy_at(data + from + i - 1);
+                    }
+                }
+            });
+        };
+        shift(index, index + count);
+        try {
+            fill(RowPointers(fields_, index));
+        } catch (...) {
+            // Сдвиг не выбрасывает исключений, поэтому хвост возвращается на место
+            shift(index + count, index);
+            throw;
+        }
+    }
+    size_ += count;
+    return begin() + index;
+}
+
+template <typename... Fields>
+void SoaSimpleVector<Fields...>::DestroyTail(size_t first) noexcept {
+    assert(first <= size_);
+    ForEachField([this, first](auto field) {
+        std::destroy_n(std::get<decltype(field)::value>(fields_).Get() + first, size_ - first);
+    });
+    size_ = first;
+}
+
+template <typename... Fields>
+bool operator==(const SoaSimpleVector<Fields...>& lhs, const SoaSimpleVector<Fields...>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) {
+        return false;
+    }
+    bool equal = true;
+    soa_detail::ForEachIndex([&lhs, &rhs, &equal](auto field) {
+        constexpr size_t I = decltype(field)::value;
+        equal = equal && lhs.template GetField<I>() == rhs.template GetField<I>();
+    }, std::index_sequence_for<Fields...>());
+    return equal;
+}
+
+template <typename... Fields>
+bool operator!=(const SoaSimpleVector<Fields...>& lhs, const SoaSimpleVector<Fields...>& rhs) {
+    return !(lhs == rhs);
+}
@@ -1,10 +1,33 @@
 #pragma once
 
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <string>
 #include <cassert>
+#include <cstdint>
 #include <numeric>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include "simple_vector.h"
+#include "simple_vector_view.h"
+#include "capacity_hint.h"
+#include "concurrent_simple_vector.h"
+#include "incremental_simple_vector.h"
+#include "shared_simple_vector.h"
+#include "small_simple_vector.h"
+#include "soa_simple_vector.h"
+#include "mmap_allocator.h"
+#include "parallel_algorithms.h"
+#include "vector_file.h"
+#include <sstream>
 #include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 
@@ -417,4 +440,1458 @@ void TestNoncopiableErase() {
     auto it = v.Erase(v.begin());
     assert(it->GetX() == 1);
     std::cout << "Done!" << std::endl;
-}
\ No newline at end of file
+}
+
+struct CountedObject {
+    inline static size_t alive = 0;
+    inline static size_t constructed = 0;
+
+    CountedObject() {
+        ++alive;
+        ++constructed;
+    }
+    CountedObject(const CountedObject&) {
+        ++alive;
+        ++constructed;
+    }
+    CountedObject(CountedObject&&) noexcept {
+        ++alive;
+        ++constructed;
+    }
+    CountedObject& operator=(const CountedObject&) = default;
+    CountedObject& operator=(CountedObject&&) = default;
+    ~CountedObject() {
+        --alive;
+    }
+};
+
+void TestUninitializedCapacity() {
+    std::cout << "Test uninitialized capacity" << std::endl;
+    CountedObject::alive = 0;
+    CountedObject::constructed = 0;
+    {
+        SimpleVector<CountedObject> v(Reserve(1000));
+        assert(CountedObject::constructed == 0);
+        v.PushBack(CountedObject{});
+        v.Reserve(100000);
+        assert(CountedObject::alive == 1);
+        v.Resize(10);
+        assert(CountedObject::alive == 10);
+        v.PopBack();
+        v.Erase(v.begin());
+        assert(CountedObject::alive == 8);
+        v.Insert(v.begin() + 2, v[0]);
+        assert(CountedObject::alive == 9);
+        v.Clear();
+        assert(CountedObject::alive == 0);
+        v.Resize(3);
+    }
+    assert(CountedObject::alive == 0);
+
+    // PushBack элемента самого вектора при переполнении
+    {
+        SimpleVector<int> v{1, 2};
+        v.PushBack(v[0]);
+        v.Insert(v.begin(), v[2]);
+        assert((v == SimpleVector<int>{1, 1, 2, 1}));
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// Тип с нетривиальным деструктором, помеченный как тривиально перемещаемый
+struct RelocatableBox {
+    RelocatableBox(int value)
+        : value(std::make_unique<int>(value)) {
+    }
+
+    std::unique_ptr<int> value;
+};
+
+template <>
+struct IsTriviallyRelocatable<RelocatableBox> : std::true_type {};
+
+void TestTriviallyRelocatable() {
+    std::cout << "Test trivially relocatable" << std::endl;
+    static_assert(IsTriviallyRelocatableV<int>);
+    static_assert(!IsTriviallyRelocatableV<std::string>);
+    {
+        SimpleVector<int> v;
+        for (int i = 0; i < 100; ++i) {
+            v.Insert(v.begin() + v.GetSize() / 2, i);
+        }
+        v.Reserve(1000);
+        assert(v.GetSize() == 100);
+        for (size_t i = 0; i < 50; ++i) {
+            v.Erase(v.begin());
+        }
+        assert(v.GetSize() == 50);
+        assert(v[0] == 98 && v[49] == 0);
+    }
+    {
+        SimpleVector<RelocatableBox> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(RelocatableBox(i));
+        }
+        v.Insert(v.begin(), RelocatableBox(-1));
+        v.Reserve(100);
+        v.Erase(v.begin() + 5);
+        assert(v.GetSize() == 10);
+        assert(*v[0].value == -1 && *v[5].value == 5 && *v[9].value == 9);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestMoveAssignmentStealsBuffer() {
+    std::cout << "Test move assignment steals buffer" << std::endl;
+    static_assert(std::is_nothrow_move_assignable_v<SimpleVector<int>>);
+    static_assert(std::is_nothrow_move_constructible_v<SimpleVector<int>>);
+    {
+        SimpleVector<int> source = GenerateVector(1000);
+        const auto old_begin = source.begin();
+        SimpleVector<int> target{1, 2, 3};
+        target = std::move(source);
+        assert(target.begin() == old_begin);
+        assert(target.GetSize() == 1000);
+        assert(source.GetSize() == 0 && source.GetCapacity() == 0);
+    }
+    {
+        SimpleVector<X> source;
+        source.PushBack(X(7));
+        SimpleVector<X> target;
+        target = std::move(source);
+        assert(target[0].GetX() == 7);
+    }
+    // Копия сообщает ровно ту вместимость, которую выделила
+    {
+        SimpleVector<int> v(Reserve(100));
+        v.PushBack(1);
+        SimpleVector<int> copy(v);
+        assert(copy.GetCapacity() == copy.GetSize());
+        copy.PushBack(2);
+        assert((copy == SimpleVector<int>{1, 2}));
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestEmplace() {
+    std::cout << "Test emplace" << std::endl;
+    {
+        SimpleVector<std::pair<std::string, int>> v;
+        auto& back = v.EmplaceBack("b"s, 2);
+        assert(&back == &v[0]);
+        v.EmplaceBack("d"s, 4);
+        auto it = v.Emplace(v.begin() + 1, "c"s, 3);
+        assert(it == v.begin() + 1 && it->second == 3);
+        it = v.Emplace(v.begin(), "a"s, 1);
+        assert(it == v.begin());
+        v.Emplace(v.end(), v[0]);
+        assert(v.GetSize() == 5);
+        for (int i = 0; i < 4; ++i) {
+            assert(v[static_cast<size_t>(i)].second == i + 1);
+        }
+        assert(v[4].first == "a"s);
+    }
+    {
+        SimpleVector<X> v;
+        v.EmplaceBack(1u);
+        v.Emplace(v.begin(), 0u);
+        assert(v[0].GetX() == 0 && v[1].GetX() == 1);
+    }
+    {
+        // Элемент создаётся на месте и не требует присваивания перемещением
+        struct Labeled {
+            const std::string label;
+            int value = 0;
+        };
+        static_assert(!std::is_move_assignable_v<Labeled>);
+        SimpleVector<Labeled> v(Reserve(4));
+        v.EmplaceBack(Labeled{"a"s, 1});
+        v.EmplaceBack(Labeled{"c"s, 3});
+        auto it = v.Emplace(v.begin() + 1, Labeled{"b"s, 2});
+        assert(it == v.begin() + 1 && v.GetCapacity() == 4);
+        assert(v[0].label == "a"s && v[1].label == "b"s && v[2].label == "c"s);
+    }
+    {
+        // Аргумент может ссылаться на элемент, сдвигаемый вставкой
+        SimpleVector<std::string> v(Reserve(4));
+        v.PushBack("a"s);
+        v.PushBack("b"s);
+        v.Emplace(v.begin(), v[0]);
+        v.Emplace(v.begin() + 1, std::move(v[2]));
+        assert(v.GetSize() == 4 && v[0] == "a"s && v[1] == "b"s && v[2] == "a"s);
+    }
+    // Количество конструирований при EmplaceBack в зарезервированную память
+    {
+        CountedObject::constructed = 0;
+        SimpleVector<CountedObject> v(Reserve(10));
+        for (int i = 0; i < 10; ++i) {
+            v.EmplaceBack();
+        }
+        assert(CountedObject::constructed == 10);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// Аллокатор с состоянием, подсчитывающий число выделенных и освобождённых блоков
+template <typename Type>
+class CountingAllocator {
+public:
+    using value_type = Type;
+
+    explicit CountingAllocator(int* allocations)
+        : allocations_(allocations) {
+    }
+
+    template <typename Other>
+    CountingAllocator(const CountingAllocator<Other>& other)
+        : allocations_(other.allocations_) {
+    }
+
+    Type* allocate(size_t size) {
+        ++*allocations_;
+        return std::allocator<Type>().allocate(size);
+    }
+
+    void deallocate(Type* buf, size_t size) {
+        --*allocations_;
+        std::allocator<Type>().deallocate(buf, size);
+    }
+
+    bool operator==(const CountingAllocator& other) const {
+        return allocations_ == other.allocations_;
+    }
+
+    bool operator!=(const CountingAllocator& other) const {
+        return !(*this == other);
+    }
+
+    int* allocations_;
+};
+
+void TestAllocator() {
+    std::cout << "Test allocator" << std::endl;
+    {
+        int allocations = 0;
+        {
+            CountingAllocator<std::string> alloc(&allocations);
+            SimpleVector<std::string, CountingAllocator<std::string>> v(alloc);
+            for (int i = 0; i < 100; ++i) {
+                v.PushBack(std::to_string(i));
+            }
+            assert(allocations == 1);
+            auto copy = v;
+            assert(allocations == 2);
+            SimpleVector<std::string, CountingAllocator<std::string>> moved(std::move(copy));
+            assert(allocations == 2);
+            assert(moved == v);
+        }
+        assert(allocations == 0);
+    }
+    {
+        char buffer[4096];
+        std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        pmr::SimpleVector<int> v{{1, 2, 3}, &resource};
+        v.PushBack(4);
+        v.Insert(v.begin(), 0);
+        assert(v.GetAllocator().resource() == &resource);
+        assert(reinterpret_cast<char*>(v.begin()) >= buffer && reinterpret_cast<char*>(v.end()) <= buffer + sizeof(buffer));
+        pmr::SimpleVector<int> other(&resource);
+        other = std::move(v);
+        assert(other.GetSize() == 5 && other[4] == 4);
+
+        // Перемещение между разными источниками памяти переносит элементы поэлементно
+        pmr::SimpleVector<int> heap_vector;
+        heap_vector = std::move(other);
+        assert(heap_vector.GetAllocator().resource() == std::pmr::get_default_resource());
+        assert(heap_vector.GetSize() == 5 && other.IsEmpty());
+    }
+    {
+        // Размер буфера в байтах, не помещающийся в size_t, не выделяет усечённый блок
+        const size_t too_many = std::numeric_limits<size_t>::max() / sizeof(long) + 3;
+        SimpleVector<long> v{1};
+        try {
+            v.Reserve(too_many);
+            assert(false);
+        } catch (const std::bad_array_new_length&) {
+        }
+        assert(v.GetCapacity() == 1 && v[0] == 1);
+        try {
+            SimpleVector<std::string> strings(Reserve(std::numeric_limits<size_t>::max() / 2));
+            assert(false);
+        } catch (const std::bad_array_new_length&) {
+        }
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// Перемещение не выбрасывает исключений, а присваивание перемещением может
+struct ThrowingSwap {
+    ThrowingSwap() = default;
+    ThrowingSwap(ThrowingSwap&&) noexcept = default;
+    ThrowingSwap& operator=(ThrowingSwap&&) noexcept(false) {
+        return *this;
+    }
+};
+
+void TestSmallSimpleVector() {
+    std::cout << "Test small simple vector" << std::endl;
+    {
+        SmallSimpleVector<int, 4> v;
+        assert(v.GetCapacity() == 4 && v.IsInline());
+        for (int i = 0; i < 4; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.IsInline());
+        v.Insert(v.begin() + 1, 10);
+        assert(!v.IsInline() && v.GetCapacity() == 8);
+        assert((v == SmallSimpleVector<int, 4>{0, 10, 1, 2, 3}));
+        v.Erase(v.begin());
+        assert((v == SmallSimpleVector<int, 4>{10, 1, 2, 3}));
+        assert((v < SmallSimpleVector<int, 4>{10, 2}));
+    }
+    {
+        SmallSimpleVector<std::string, 2> small{"a"s};
+        SmallSimpleVector<std::string, 2> large{"b"s, "c"s, "d"s};
+        small.Swap(large);
+        assert(small.GetSize() == 3 && !small.IsInline() && small[2] == "d"s);
+        assert(large.GetSize() == 1 && large.IsInline() && large[0] == "a"s);
+
+        SmallSimpleVector<std::string, 2> other{"x"s, "y"s};
+        other.Swap(large);
+        assert(other.GetSize() == 1 && other[0] == "a"s);
+        assert(large.GetSize() == 2 && large[1] == "y"s);
+
+        SmallSimpleVector<std::string, 2> copy(small);
+        assert(copy == small);
+        SmallSimpleVector<std::string, 2> moved(std::move(large));
+        assert(moved.GetSize() == 2 && large.IsEmpty());
+        moved = std::move(copy);
+        assert(moved == small && copy.IsEmpty());
+        static_assert(std::is_nothrow_move_assignable_v<SmallSimpleVector<std::string, 2>>);
+        static_assert(!std::is_nothrow_move_assignable_v<SmallSimpleVector<ThrowingSwap, 2>>);
+    }
+    {
+        // Вместимость после встроенного буфера растёт согласно политике роста
+        SmallSimpleVector<int, 4, MallocAllocator<int>, OneAndHalfGrowth> v;
+        for (int i = 0; i < 7; ++i) {
+            v.PushBack(i);
+        }
+        assert(!v.IsInline() && v.GetCapacity() == 9);
+        // Последовательные Resize тоже растут согласно политике, а не до точного размера
+        v.Resize(10);
+        assert(v.GetCapacity() == 13 && v[6] == 6 && v[9] == 0);
+        v.Resize(11);
+        assert(v.GetCapacity() == 13);
+    }
+    {
+        SmallSimpleVector<X, 3> v;
+        for (size_t i = 0; i < 5; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Reserve(100);
+        v.Resize(3);
+        assert(v.GetCapacity() == 100 && v[2].GetX() == 2);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestRangeOperations() {
+    std::cout << "Test range operations" << std::endl;
+    {
+        SimpleVector<int> v{1, 2, 6};
+        const int values[] = {3, 4, 5};
+        auto it = v.Insert(v.begin() + 2, std::begin(values), std::end(values));
+        assert(it == v.begin() + 2);
+        assert((v == SimpleVector<int>{1, 2, 3, 4, 5, 6}));
+        v.Reserve(20);
+        v.Insert(v.begin(), 2, v[5]);
+        assert((v == SimpleVector<int>{6, 6, 1, 2, 3, 4, 5, 6}));
+        it = v.Erase(v.begin(), v.begin() + 3);
+        assert(*it == 2);
+        assert((v == SimpleVector<int>{2, 3, 4, 5, 6}));
+        v.Append(v);
+        assert(v.GetSize() == 10 && v[9] == 6);
+        std::istringstream input("7 8 9");
+        v.Append(std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert(v.GetSize() == 13 && v[12] == 9);
+    }
+    {
+        SimpleVector<std::string> v{"a"s, "e"s};
+        v.Reserve(10);
+        const std::string values[] = {"b"s, "c"s, "d"s};
+        v.Insert(v.begin() + 1, std::begin(values), std::end(values));
+        assert((v == SimpleVector<std::string>{"a"s, "b"s, "c"s, "d"s, "e"s}));
+        v.Insert(v.end(), 2, "f"s);
+        v.Erase(v.begin() + 1, v.begin() + 4);
+        assert((v == SimpleVector<std::string>{"a"s, "e"s, "f"s, "f"s}));
+        v.Append(v);
+        assert(v.GetSize() == 8 && v[4] == "a"s);
+        SimpleVector<std::string> other;
+        other.Append(v.begin(), v.end());
+        assert(other == v);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestGrowthPolicy() {
+    std::cout << "Test growth policy" << std::endl;
+    assert(DoublingGrowth::NextCapacity(0, 1, 4) == 1);
+    assert(DoublingGrowth::NextCapacity(8, 9, 4) == 16);
+    assert(DoublingGrowth::NextCapacity(8, 100, 4) == 100);
+    assert(OneAndHalfGrowth::NextCapacity(0, 1, 4) == 1);
+    assert(OneAndHalfGrowth::NextCapacity(1, 2, 4) == 2);
+    assert(OneAndHalfGrowth::NextCapacity(10, 11, 4) == 15);
+    assert((PageRoundedGrowth<>::NextCapacity(4, 5, 4) == 8));
+    assert((PageRoundedGrowth<>::NextCapacity(1000, 1001, 12) * 12 % 4096 == 0));
+    assert(BucketAlignedGrowth<>::NextCapacity(0, 1, 4) == 4);
+    assert(BucketAlignedGrowth<>::NextCapacity(10, 11, 6) == 21);
+    assert(BucketAlignedGrowth<>::NextCapacity(40, 41, 1) == 80);
+    assert(BucketAlignedGrowth<>::NextCapacity(40, 41, 3) == 85);
+
+    // Resize в цикле растёт геометрически
+    {
+        SimpleVector<int> v;
+        size_t reallocations = 0;
+        for (size_t size = 1; size <= 1000; ++size) {
+            const auto old_begin = v.begin();
+            v.Resize(size);
+            reallocations += old_begin != v.begin();
+        }
+        assert(reallocations <= 11);
+    }
+    {
+        SimpleVector<int, MallocAllocator<int>, OneAndHalfGrowth> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.GetCapacity() == 13);
+        v.Insert(v.end(), 10, 0);
+        assert(v.GetSize() == 20 && v.GetCapacity() == 20);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestShrink() {
+    std::cout << "Test shrink" << std::endl;
+    {
+        SimpleVector<std::string> v(Reserve(100));
+        v.PushBack("a"s);
+        v.PushBack("b"s);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 2 && v[1] == "b"s);
+        v.Clear();
+        assert(v.GetCapacity() == 2);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 0 && v.begin() == nullptr);
+    }
+    assert((HysteresisShrink<4, 16>::ShrinkCapacity(25, 100) == 50));
+    assert((HysteresisShrink<4, 16>::ShrinkCapacity(26, 100) == 100));
+    assert((HysteresisShrink<4, 16>::ShrinkCapacity(2, 16) == 16));
+    {
+        SimpleVector<int, MallocAllocator<int>, DoublingGrowth, HysteresisShrink<>> v(1024);
+        v.Resize(300);
+        assert(v.GetCapacity() == 1024);
+        v.Resize(256);
+        assert(v.GetCapacity() == 512);
+        // Колебания около порога не вызывают перевыделений
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+            v.PopBack();
+        }
+        assert(v.GetCapacity() == 512);
+        auto it = v.Erase(v.begin() + 10, v.begin() + 200);
+        assert(v.GetCapacity() == 132 && it == v.begin() + 10);
+        v.Clear();
+        assert(v.GetCapacity() == 16);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestMmapAllocator() {
+    std::cout << "Test mmap allocator" << std::endl;
+    static_assert(HasReallocateV<MmapAllocator<int>>);
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    {
+        SimpleVector<int, MmapAllocator<int>> v;
+        for (int i = 0; i < 1000000; ++i) {
+            v.PushBack(i);
+        }
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % page_size == 0);
+        v.Resize(10);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 10 && v[9] == 9);
+    }
+    {
+        SimpleVector<std::string, MmapAllocator<std::string, true>> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        v.Insert(v.begin(), "x"s);
+        assert(v.GetSize() == 1001 && v[1000] == "999"s);
+    }
+    try {
+        MmapAllocator<long>().allocate(std::numeric_limits<size_t>::max() / sizeof(long));
+        assert(false);
+    } catch (const std::bad_array_new_length&) {
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+struct alignas(32) Vec8f {
+    float values[8];
+};
+
+void TestAlignment() {
+    std::cout << "Test alignment" << std::endl;
+    static_assert(AlignedSimpleVector<float>::GetAlignment() == 64);
+    static_assert(AlignedSimpleVector<float, PAGE_ALIGNMENT>::GetAlignment() == 4096);
+    static_assert(SimpleVector<Vec8f>::GetAlignment() == 32);
+    static_assert(SimpleVector<int, MmapAllocator<int>>::GetAlignment() == 4096);
+    {
+        AlignedSimpleVector<float> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.Insert(v.begin(), static_cast<float>(i));
+            assert(reinterpret_cast<uintptr_t>(v.begin()) % 64 == 0);
+        }
+        v.Resize(3);
+        v.ShrinkToFit();
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % 64 == 0);
+        assert(v[0] == 999.0f);
+    }
+    {
+        SimpleVector<Vec8f> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(Vec8f{});
+            assert(reinterpret_cast<uintptr_t>(v.begin()) % 32 == 0);
+        }
+    }
+    {
+        // Размер в байтах, в том числе округлённый до выравнивания, не должен переполняться
+        MallocAllocator<long> malloc_alloc;
+        MallocAllocator<Vec8f> aligned_malloc_alloc;
+        try {
+            malloc_alloc.allocate(std::numeric_limits<size_t>::max() / sizeof(long) + 3);
+            assert(false);
+        } catch (const std::bad_array_new_length&) {
+        }
+        long* buf = malloc_alloc.allocate(4);
+        try {
+            buf = malloc_alloc.reallocate(buf, 4, std::numeric_limits<size_t>::max() / 4);
+            assert(false);
+        } catch (const std::bad_array_new_length&) {
+        }
+        malloc_alloc.deallocate(buf, 4);
+        try {
+            aligned_malloc_alloc.allocate(std::numeric_limits<size_t>::max() / sizeof(Vec8f) + 1);
+            assert(false);
+        } catch (const std::bad_array_new_length&) {
+        }
+        try {
+            AlignedAllocator<long, CACHE_LINE_ALIGNMENT>().allocate(std::numeric_limits<size_t>::max() / sizeof(long) + 3);
+            assert(false);
+        } catch (const std::bad_array_new_length&) {
+        }
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// Сравнения выбрасывают исключение для отрицательных значений
+struct ThrowingCompare {
+    int value = 0;
+
+    bool operator==(const ThrowingCompare& other) const {
+        Check(other);
+        return value == other.value;
+    }
+
+    bool operator<(const ThrowingCompare& other) const {
+        Check(other);
+        return value < other.value;
+    }
+
+    void Check(const ThrowingCompare& other) const {
+        if (value < 0 || other.value < 0) {
+            throw std::invalid_argument("negative");
+        }
+    }
+};
+
+void TestSearchAndCompareKernels() {
+    std::cout << "Test search and compare kernels" << std::endl;
+    {
+        SimpleVector<int> v(1000);
+        std::iota(v.begin(), v.end(), 0);
+        v[700] = -5;
+        v[900] = 5000;
+        assert(v.Find(500) == v.begin() + 500);
+        assert(v.Find(12345) == v.end());
+        assert(v.Contains(999) && !v.Contains(700));
+        v[3] = 5;
+        assert(v.Count(5) == 2);
+        assert(v.Min() == v.begin() + 700);
+        assert(v.Max() == v.begin() + 900);
+        *v.Find(5) = 6;
+        assert(v[3] == 6);
+
+        SimpleVector<int> copy(v);
+        assert(copy == v && copy.Hash() == v.Hash());
+        copy[999] = 0;
+        assert(copy != v && copy < v);
+        copy.PopBack();
+        assert(copy < v);
+        assert(!(v < v));
+    }
+    {
+        SimpleVector<double> v{1.0, -0.0, 3.5};
+        assert(v.Find(0.0) == v.begin() + 1);
+        assert((v == SimpleVector<double>{1.0, 0.0, 3.5}));
+        assert((v.Hash() == SimpleVector<double>{1.0, 0.0, 3.5}.Hash()));
+        assert(*v.Min() == -0.0 && *v.Max() == 3.5);
+    }
+    {
+        SimpleVector<std::string> v{"b"s, "a"s, "c"s};
+        assert(v.Find("a"s) == v.begin() + 1);
+        assert(*v.Min() == "a"s && v.Count("c"s) == 1);
+        std::hash<SimpleVector<std::string>> hasher;
+        assert(hasher(v) == hasher(SimpleVector<std::string>(v)));
+        SimpleVector<std::string> empty;
+        assert(empty.Min() == empty.end() && !empty.Contains(""s));
+    }
+    {
+        // Исключение из пользовательского сравнения доходит до вызывающего кода
+        static_assert(noexcept(SimpleVector<int>().Find(0)) && noexcept(SimpleVector<int>().Hash()));
+        static_assert(!noexcept(SimpleVector<ThrowingCompare>().Count(ThrowingCompare{})));
+        static_assert(!noexcept(SimpleVector<ThrowingCompare>().Max()));
+        SimpleVector<ThrowingCompare> v{{1}, {-1}, {2}};
+        try {
+            v.Find(ThrowingCompare{2});
+            assert(false);
+        } catch (const std::invalid_argument&) {
+        }
+        try {
+            v.Min();
+            assert(false);
+        } catch (const std::invalid_argument&) {
+        }
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestParallelAlgorithms() {
+    std::cout << "Test parallel algorithms" << std::endl;
+    ThreadPool pool(4);
+    ParallelOptions options;
+    options.pool = &pool;
+    options.grain_size = 1000;
+    options.serial_threshold = 2000;
+
+    const size_t size = 100000;
+    SimpleVector<int> v(size);
+    ParallelFill(v.begin(), v.end(), 1, options);
+    assert(v.Count(1) == size);
+    ParallelForEach(v.begin() + 10, v.end(), [](int& x) { x = 2; }, options);
+    assert(v.Count(2) == size - 10);
+    SimpleVector<int64_t> squares(size);
+    std::iota(v.begin(), v.end(), 0);
+    ParallelTransform(v.begin(), v.end(), squares.begin(), [](int x) { return int64_t{x} * x; }, options);
+    assert(squares[size - 1] == int64_t{size - 1} * (size - 1));
+    assert(ParallelReduce(v.begin(), v.end(), int64_t{0}, std::plus<>{}, std::plus<>{}, options) == int64_t{size} * (size - 1) / 2);
+    assert(ParallelReduce(v.begin(), v.begin() + 3000, 5, std::plus<>{}, options) == 5 + 3000 * 2999 / 2);
+    {
+        // Накопитель другого типа, чем элементы: результаты кусков объединяются combine
+        const SimpleVector<int> threes(200000, 3);
+        const auto square_sum = [](int64_t sum, int x) { return sum + int64_t{x} * x; };
+        assert(ParallelReduce(threes.begin(), threes.end(), int64_t{0}, square_sum, std::plus<>{}, options) == 1800000);
+        options.deterministic = true;
+        assert(ParallelReduce(threes.begin(), threes.end(), int64_t{1}, square_sum, std::plus<>{}, options) == 1800001);
+        options.deterministic = false;
+    }
+
+    // Детерминированная свёртка не зависит от числа потоков
+    SimpleVector<double> doubles(size);
+    for (size_t i = 0; i < size; ++i) {
+        doubles[i] = 1.0 / static_cast<double>(i + 1);
+    }
+    options.deterministic = true;
+    const double sum = ParallelReduce(doubles.begin(), doubles.end(), 0.0, std::plus<>{}, options);
+    ThreadPool single(1);
+    ParallelOptions single_options = options;
+    single_options.pool = &single;
+    assert(sum == ParallelReduce(doubles.begin(), doubles.end(), 0.0, std::plus<>{}, single_options));
+    {
+        // Детерминированная свёртка сохраняет порядок кусков, поэтому годится для
+        // некоммутативных операций
+        SimpleVector<std::string> letters(5000);
+        std::string expected;
+        for (size_t i = 0; i < letters.GetSize(); ++i) {
+            letters[i] = std::string(1, static_cast<char>('a' + i % 26));
+            expected += letters[i];
+        }
+        assert(ParallelReduce(letters.begin(), letters.end(), ""s, std::plus<>{}, options) == expected);
+    }
+
+    std::reverse(v.begin(), v.end());
+    ParallelSort(v.begin(), v.end(), std::less<>{}, options);
+    assert(std::is_sorted(v.begin(), v.end()) && v[0] == 0);
+
+    // Вложенный параллельный вызов и исключение из пользовательской функции
+    SimpleVector<int64_t> sums(4);
+    ParallelForEach(sums.begin(), sums.end(), [&](int64_t& s) {
+        s = ParallelReduce(v.begin(), v.end(), int64_t{0}, std::plus<>{}, std::plus<>{}, options);
+    }, ParallelOptions{1, 0, &pool, false});
+    assert(sums.Count(sums[0]) == 4);
+    try {
+        ParallelForEach(v.begin(), v.end(), [](int x) {
+            if (x == 50000) {
+                throw std::runtime_error("stop");
+            }
+        }, options);
+        assert(false);
+    } catch (const std::runtime_error&) {
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+struct alignas(64) ParallelBlock {
+    inline static std::atomic<int64_t> alive = 0;
+    int value = 0;
+
+    ParallelBlock() {
+        ++alive;
+    }
+    ParallelBlock(const ParallelBlock& other) : value(other.value) {
+        if (value < 0) {
+            throw std::runtime_error("copy");
+        }
+        ++alive;
+    }
+    ~ParallelBlock() {
+        --alive;
+    }
+};
+
+// Конструкторы ParallelBlock изменяют только атомарный счётчик
+template <>
+struct IsParallelConstructible<ParallelBlock> : std::true_type {};
+
+struct SerialBlock {
+    inline static size_t constructed = 0;
+    int value = 0;
+
+    SerialBlock() {
+        ++constructed;
+    }
+};
+
+void TestParallelInitialization() {
+    std::cout << "Test parallel initialization" << std::endl;
+    const size_t size = PARALLEL_INIT_THRESHOLD / sizeof(int) * 2;
+    {
+        SimpleVector<int> v(size, 7);
+        assert(v.Count(7) == size);
+        SimpleVector<int> copy(v);
+        assert(copy == v);
+        SimpleVector<int> zeros(size);
+        assert(zeros.Count(0) == size);
+        SimpleVector<int> resized(10, 3);
+        resized.Resize(size);
+        assert(resized.Count(3) == 10 && resized.Count(0) == size - 10);
+    }
+    {
+        // Исключение в одной из частей разрушает элементы, созданные другими потоками
+        const size_t count = PARALLEL_INIT_THRESHOLD / sizeof(ParallelBlock) * 2;
+        ParallelBlock::alive = 0;
+        SimpleVector<ParallelBlock> blocks(count);
+        assert(ParallelBlock::alive == static_cast<int64_t>(count));
+        blocks[count - 1].value = -1;
+        try {
+            SimpleVector<ParallelBlock> copy(blocks);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(ParallelBlock::alive == static_cast<int64_t>(count));
+    }
+    assert(ParallelBlock::alive == 0);
+    {
+        // Типы без признака создаются одним потоком, даже если меняют общее неатомарное состояние
+        static_assert(IsParallelConstructibleV<int> && !IsParallelConstructibleV<SerialBlock>);
+        static_assert(!IsParallelConstructibleV<std::string>);
+        const size_t count = PARALLEL_INIT_THRESHOLD / sizeof(SerialBlock) * 2;
+        SerialBlock::constructed = 0;
+        SimpleVector<SerialBlock> blocks(count);
+        assert(SerialBlock::constructed == count);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+struct InstrumentedValue {
+    int value = 0;
+};
+
+void TestInstrumentation() {
+    std::cout << "Test instrumentation" << std::endl;
+    ResetVectorStats<InstrumentedValue>();
+    {
+        SimpleVector<InstrumentedValue> v;
+        for (int i = 0; i < 8; ++i) {
+            v.PushBack({i});
+        }
+        v.Reserve(16);
+        v.Insert(v.begin(), {-1});
+        v.Erase(v.begin());
+        v.Erase(v.begin(), v.begin() + 2);
+        const VectorStats stats = GetVectorStats<InstrumentedValue>();
+        if constexpr (INSTRUMENTATION_ENABLED) {
+            // Рост до 1, 2, 4, 8 и Reserve(16)
+            assert(stats.allocations == 5 && stats.deallocations == 4);
+            assert(stats.reallocations == 5 && stats.elements_relocated == 0 + 1 + 2 + 4 + 8);
+            assert(stats.elements_shifted == 8 + 8 + 6);
+            assert(stats.peak_capacity_bytes == 16 * sizeof(InstrumentedValue));
+            assert(stats.GetBytesInUse() == 16 * sizeof(InstrumentedValue));
+            assert(GetGlobalVectorStats().allocations >= stats.allocations);
+        }
+        else {
+            assert(stats.allocations == 0 && stats.elements_relocated == 0 && stats.peak_capacity_bytes == 0);
+        }
+    }
+    assert(GetVectorStats<InstrumentedValue>().GetBytesInUse() == 0);
+    ResetVectorStats<InstrumentedValue>();
+    assert(GetVectorStats<InstrumentedValue>().allocations == 0);
+    std::cout << "Done!" << std::endl;
+}
+
+void TestProfiling() {
+    std::cout << "Test profiling" << std::endl;
+    // Место создания передаётся явно, но не преобразуется в вектор неявно
+    static_assert(std::is_constructible_v<SimpleVector<int>, SourceLocation>);
+    static_assert(!std::is_convertible_v<SourceLocation, SimpleVector<int>>);
+    static_assert(std::is_nothrow_default_constructible_v<SimpleVector<int>>);
+#ifndef SIMPLE_VECTOR_PROFILING
+    // Выключенный профиль не увеличивает вектор
+    assert(sizeof(SimpleVector<int>) == sizeof(ArrayPtr<int>) + 2 * sizeof(size_t));
+#else
+    ResetVectorProfile();
+    unsigned growing_line = 0;
+    for (int i = 0; i < 3; ++i) {
+        SimpleVector<int> v; growing_line = __LINE__;
+        for (int j = 0; j < 100; ++j) {
+            v.PushBack(j);
+        }
+    }
+    unsigned reserve_line = 0;
+    {
+        SimpleVector<int> v;
+        v.Reserve(10); reserve_line = __LINE__;
+        v.PushBack(1);
+        SimpleVector<int> moved(std::move(v));
+    }
+    unsigned created_line = 0;
+    unsigned noop_reserve_line = 0;
+    {
+        // Reserve без перевыделения не меняет место вектора
+        SimpleVector<int> v(10); created_line = __LINE__;
+        v.Reserve(5); noop_reserve_line = __LINE__;
+    }
+    bool found_created = false;
+    bool found_growing = false;
+    bool found_reserve = false;
+    for (const SiteProfile& site : GetVectorProfile()) {
+        if (site.location.line == growing_line) {
+            found_growing = true;
+            assert(site.vectors == 3 && site.max_final_size == 100 && site.max_peak_capacity == 128);
+            assert(site.max_growths == 8 && site.wasted_bytes == 3 * 28 * sizeof(int));
+        }
+        assert(site.location.line != noop_reserve_line);
+        if (site.location.line == created_line) {
+            found_created = true;
+            assert(site.vectors == 1 && site.max_final_size == 10);
+        }
+        if (site.location.line == reserve_line) {
+            // Перемещённый вектор учитывается один раз
+            found_reserve = true;
+            assert(site.vectors == 1 && site.max_growths == 1 && site.wasted_bytes == 9 * sizeof(int));
+        }
+    }
+    assert(found_growing && found_reserve && found_created);
+    std::ostringstream report;
+    WriteVectorProfileReport(report);
+    assert(report.str().find("hint: Reserve(100)") != std::string::npos);
+#endif
+    std::cout << "Done!" << std::endl;
+}
+
+void TestCapacityHint() {
+    std::cout << "Test capacity hint" << std::endl;
+    auto fill = [](size_t count, bool fail) {
+        CapacityHint& hint = SIMPLE_VECTOR_CAPACITY_HINT();
+        SimpleVector<int> v(Reserve(hint));
+        CapacityRecorder recorder(hint, v);
+        const size_t capacity = v.GetCapacity();
+        for (size_t i = 0; i < count; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        if (fail) {
+            throw std::runtime_error("fill");
+        }
+        return capacity;
+    };
+    assert(fill(100, false) == 0);
+    assert(fill(100, false) == 100);
+    assert(fill(100, false) == 100);
+    // Размер записывается и при выходе по исключению
+    try {
+        fill(150, true);
+        assert(false);
+    } catch (const std::runtime_error&) {
+    }
+    assert(fill(10, false) == 150);
+    {
+        CapacityHint& hint = GetCapacityHint("dismissed");
+        SimpleVector<int> v(5);
+        CapacityRecorder recorder(hint, v);
+        recorder.Dismiss();
+    }
+    assert(GetCapacityHint("dismissed").Predict() == 0);
+
+    // Предсказание — наибольший из последних HISTORY_SIZE размеров
+    CapacityHint& tagged = GetCapacityHint("requests");
+    assert(&tagged == &GetCapacityHint("requests") && &tagged != &GetCapacityHint("other"));
+    tagged.Record(1000);
+    for (size_t i = 0; i < CapacityHint::HISTORY_SIZE - 1; ++i) {
+        tagged.Record(10);
+    }
+    assert(tagged.Predict() == 1000);
+    tagged.Record(20);
+    assert(tagged.Predict() == 20);
+    tagged.Reset();
+    assert(tagged.Predict() == 0);
+    std::cout << "Done!" << std::endl;
+}
+
+void TestSharedSimpleVector() {
+    std::cout << "Test shared simple vector" << std::endl;
+    SimpleVector<std::string> source = {"a"s, "b"s, "c"s};
+    const std::string* data = source.begin();
+    SharedSimpleVector<std::string> shared(std::move(source));
+    assert(shared.begin() == data && shared.IsUnique());
+
+    // Копии разделяют буфер до первого изменения
+    SharedSimpleVector<std::string> copy = shared;
+    assert(copy.GetUseCount() == 2 && std::as_const(copy).begin() == data);
+    copy.PushBack("d"s);
+    assert(shared.IsUnique() && copy.IsUnique() && std::as_const(shared).begin() == data);
+    assert(shared.GetSize() == 3 && copy.GetSize() == 4 && shared < copy);
+
+    SharedSimpleVector<std::string> other = shared;
+    other[0] = "z"s;
+    assert(shared[0] == "a"s && other[0] == "z"s);
+    other = shared;
+    other.Insert(other.cbegin() + 1, std::as_const(other)[2]);
+    assert(other == SharedSimpleVector<std::string>({"a"s, "c"s, "b"s, "c"s}) && shared.GetSize() == 3);
+    other = shared;
+    other.Erase(std::as_const(other).begin());
+    assert(other.GetSize() == 2 && shared.GetSize() == 3 && other[0] == "b"s);
+    {
+        // PopBack копирует из разделённого буфера только остающиеся элементы
+        SharedSimpleVector<CountedObject> objects(SimpleVector<CountedObject>(10));
+        SharedSimpleVector<CountedObject> objects_copy = objects;
+        CountedObject::constructed = 0;
+        objects_copy.PopBack();
+        assert(CountedObject::constructed == 9 && objects_copy.GetSize() == 9 && objects_copy.GetCapacity() == 9);
+        assert(objects.IsUnique() && objects.GetSize() == 10);
+
+        // Erase тоже не копирует удаляемые элементы
+        objects_copy = objects;
+        CountedObject::constructed = 0;
+        auto it = objects_copy.Erase(std::as_const(objects_copy).begin() + 2, std::as_const(objects_copy).begin() + 5);
+        assert(CountedObject::constructed == 7 && objects_copy.GetSize() == 7 && it == objects_copy.begin() + 2);
+        objects_copy = objects;
+        CountedObject::constructed = 0;
+        objects_copy.Erase(std::as_const(objects_copy).begin());
+        assert(CountedObject::constructed == 9 && objects_copy.GetCapacity() == 9 && objects.GetSize() == 10);
+    }
+    {
+        SharedSimpleVector<int> empty;
+        assert(empty.Erase(empty.cbegin(), empty.cend()) == empty.end());
+    }
+
+    // Единственный владелец отдаёт буфер без копирования, разделённый буфер копируется
+    SharedSimpleVector<std::string> keeper = shared;
+    SimpleVector<std::string> copied = std::move(keeper).ToSimpleVector();
+    assert(copied.begin() != data && keeper.IsEmpty() && shared.IsUnique());
+    SimpleVector<std::string> released = std::move(shared).ToSimpleVector();
+    assert(released.begin() == data && shared.GetUseCount() == 0);
+
+    // Читатели в разных потоках копируют и читают общий буфер
+    SharedSimpleVector<int> numbers(SimpleVector<int>(1000, 1));
+    SimpleVector<std::thread> readers;
+    std::atomic<int> sum = 0;
+    for (int i = 0; i < 4; ++i) {
+        readers.EmplaceBack([numbers, &sum] {
+            SharedSimpleVector<int> local = numbers;
+            int local_sum = 0;
+            for (const int x : std::as_const(local)) {
+                local_sum += x;
+            }
+            sum += local_sum;
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    assert(sum == 4000 && numbers.IsUnique());
+    std::cout << "Done!" << std::endl;
+}
+
+struct ThrowingFromInt {
+    std::string value;
+
+    explicit ThrowingFromInt(int x) : value(std::to_string(x)) {
+        if (x < 0) {
+            throw std::invalid_argument("negative");
+        }
+    }
+};
+
+void TestConcurrentSimpleVector() {
+    std::cout << "Test concurrent simple vector" << std::endl;
+    {
+        ConcurrentSimpleVector<std::string> v;
+        assert(v.PushBack("a"s) == 0 && v.EmplaceBack(3, 'b') == 1);
+        const std::string* first = &v[0];
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        // Рост не перемещает элементы
+        assert(&v[0] == first && v[1] == "bbb"s && v[1001] == "999"s);
+        assert(v.GetSize() == 1002 && v.GetPublishedSize() == 1002 && v.TryGet(2000) == nullptr);
+        SimpleVector<std::string> copy = v.ToSimpleVector();
+        assert(copy.GetSize() == 1002 && copy[2] == "0"s);
+    }
+    {
+        ConcurrentSimpleVector<ThrowingFromInt> v;
+        v.EmplaceBack(1);
+        try {
+            v.EmplaceBack(-1);
+            assert(false);
+        } catch (const std::invalid_argument&) {
+        }
+        assert(v.GetSize() == 1 && v.EmplaceBack(2) == 1 && v.GetPublishedSize() == 2);
+    }
+    {
+        // Писатели добавляют элементы, читатель обходит снимки опубликованного префикса
+        constexpr int writers = 4;
+        constexpr int per_writer = 20000;
+        ConcurrentSimpleVector<int64_t> v;
+        SimpleVector<SimpleVector<size_t>> indices(writers);
+        std::atomic<bool> done = false;
+        std::thread reader([&] {
+            size_t last = 0;
+            while (!done.load()) {
+                const auto snapshot = v.GetSnapshot();
+                assert(snapshot.GetSize() >= last);
+                last = snapshot.GetSize();
+                for (const int64_t x : snapshot) {
+                    assert(x >= 0 && x < writers * per_writer);
+                }
+            }
+        });
+        SimpleVector<std::thread> threads;
+        for (int w = 0; w < writers; ++w) {
+            threads.EmplaceBack([&v, &indices, w] {
+                for (int i = 0; i < per_writer; ++i) {
+                    const int64_t value = int64_t{w} * per_writer + i;
+                    const size_t index = v.PushBack(value);
+                    assert(v[index] == value);
+                    indices[w].PushBack(index);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        done = true;
+        reader.join();
+        assert(v.GetPublishedSize() == writers * per_writer);
+        SimpleVector<bool> seen(writers * per_writer, false);
+        for (int w = 0; w < writers; ++w) {
+            for (int i = 0; i < per_writer; ++i) {
+                assert(v[indices[w][i]] == int64_t{w} * per_writer + i);
+                assert(!seen[indices[w][i]]);
+                seen[indices[w][i]] = true;
+            }
+        }
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestIncrementalSimpleVector() {
+    std::cout << "Test incremental simple vector" << std::endl;
+    {
+        IncrementalSimpleVector<std::string, MallocAllocator<std::string>, DoublingGrowth, 2> v;
+        for (int i = 0; i < 9; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        // После роста с 8 до 16 перенесены только первые два элемента
+        assert(v.GetSize() == 9 && v.GetCapacity() == 16 && v.IsGrowing());
+        for (int i = 0; i < 9; ++i) {
+            assert(v[i] == std::to_string(i) && v.At(i) == std::to_string(i));
+        }
+        assert(std::equal(v.begin(), v.end(), v.begin()) && v.end() - v.begin() == 9);
+        // Элемент, ещё лежащий в старом буфере, можно добавить в сам вектор
+        v.PushBack(v[7]);
+        assert(v[9] == "7"s && v.IsGrowing());
+        v.PushBack("10"s);
+        v.PushBack("11"s);
+        assert(!v.IsGrowing());
+        for (size_t i = 0; i < 9; ++i) {
+            assert(v[i] == std::to_string(i));
+        }
+        try {
+            v.At(12);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+    }
+    {
+        // При росте в полтора раза шаг увеличивается, и перенос заканчивается до следующего роста
+        IncrementalSimpleVector<int, MallocAllocator<int>, OneAndHalfGrowth, 1> v;
+        for (int i = 0; i < 1000; ++i) {
+            assert(v.GetSize() < v.GetCapacity() || !v.IsGrowing());
+            v.PushBack(i);
+        }
+        for (int i = 0; i < 1000; ++i) {
+            assert(v[i] == i);
+        }
+    }
+    {
+        // Удаление элементов во время переноса и повторный рост
+        IncrementalSimpleVector<std::string, MallocAllocator<std::string>, DoublingGrowth, 1> v;
+        for (int i = 0; i < 5; ++i) {
+            v.EmplaceBack(3, static_cast<char>('a' + i));
+        }
+        assert(v.IsGrowing());
+        v.PopBack();
+        v.PopBack();
+        assert(v.GetSize() == 3 && v[2] == "ccc"s);
+        for (int i = 0; i < 6; ++i) {
+            v.PushBack("x"s);
+        }
+        assert(v.GetSize() == 9 && v[0] == "aaa"s && v[2] == "ccc"s && v[8] == "x"s);
+        auto moved = std::move(v);
+        assert(v.IsEmpty() && moved.GetSize() == 9 && *moved.cbegin() == "aaa"s);
+        moved.Reserve(100);
+        assert(!moved.IsGrowing() && moved.GetCapacity() == 100 && moved[1] == "bbb"s);
+        moved.Clear();
+        assert(moved.IsEmpty() && moved.GetCapacity() == 100);
+    }
+    {
+        IncrementalSimpleVector<int> v;
+        for (int i = 0; i < 100000; ++i) {
+            v.PushBack(i);
+            assert(v[i / 2] == i / 2);
+        }
+        for (auto it = v.begin(); it != v.end(); ++it) {
+            *it += 1;
+        }
+        assert(std::accumulate(v.cbegin(), v.cend(), int64_t{0}) == int64_t{100000} * 100001 / 2);
+        std::sort(v.begin(), v.end(), std::greater<>());
+        assert(v[0] == 100000 && v[99999] == 1);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestVectorFile() {
+    std::cout << "Test vector file" << std::endl;
+    struct Point {
+        int32_t x;
+        double y;
+    };
+    const std::string path = "/tmp/simple_vector_test_"s + std::to_string(::getpid()) + ".bin"s;
+    {
+        SimpleVector<int64_t> v(1000);
+        std::iota(v.begin(), v.end(), int64_t{-500});
+        SaveTo(v, path);
+        const auto loaded = LoadFrom<int64_t>(path);
+        assert(loaded == v && loaded.GetCapacity() == 1000);
+        MappedSimpleVector<int64_t> mapped(path);
+        assert(mapped.GetSize() == 1000 && mapped[0] == -500 && mapped.At(999) == 499);
+        assert(std::equal(mapped.begin(), mapped.end(), v.begin()) && mapped.VerifyChecksum());
+        assert(reinterpret_cast<uintptr_t>(mapped.begin()) % alignof(int64_t) == 0);
+        assert(mapped.ToSimpleVector() == v);
+        auto moved = std::move(mapped);
+        assert(mapped.IsEmpty() && moved.GetSize() == 1000);
+        // Файл другого типа не читается
+        try {
+            LoadFrom<int32_t>(path);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+    }
+    {
+        SimpleVector<Point> v{{1, 0.5}, {2, 1.5}};
+        SaveTo(v, path);
+        const auto loaded = LoadFrom<Point>(path);
+        assert(loaded.GetSize() == 2 && loaded[1].x == 2 && loaded[1].y == 1.5);
+        SaveTo(SimpleVector<Point>(), path);
+        assert(LoadFrom<Point>(path).IsEmpty() && MappedSimpleVector<Point>(path).IsEmpty());
+    }
+    {
+        // Повреждённое содержимое обнаруживается по контрольной сумме
+        SaveTo(SimpleVector<int>(100, 7), path);
+        {
+            vector_file::FileDescriptor file(path, O_WRONLY);
+            const int value = 8;
+            assert(::pwrite(file.Get(), &value, sizeof(value), vector_file::PayloadOffset<int>() + 40) == sizeof(value));
+        }
+        try {
+            LoadFrom<int>(path);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        MappedSimpleVector<int> mapped(path);
+        assert(mapped[10] == 8 && !mapped.VerifyChecksum());
+    }
+    ::unlink(path.c_str());
+    try {
+        MappedSimpleVector<int> mapped(path);
+        assert(false);
+    } catch (const std::system_error&) {
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+namespace {
+
+int64_t SumView(SimpleVectorView<const int> view) {
+    return std::accumulate(view.begin(), view.end(), int64_t{0});
+}
+
+} // namespace
+
+void TestSimpleVectorView() {
+    std::cout << "Test simple vector view" << std::endl;
+    SimpleVector<int> v(10);
+    std::iota(v.begin(), v.end(), 0);
+    // SimpleVector неявно преобразуется в представление без копирования
+    assert(SumView(v) == 45);
+    SimpleVectorView view = v;
+    static_assert(std::is_same_v<decltype(view), SimpleVectorView<int>>);
+    assert(view.GetSize() == 10 && view.begin() == v.begin() && view[3] == 3 && view.At(9) == 9);
+    view[0] = 100;
+    assert(v[0] == 100);
+    view[0] = 0;
+    {
+        const SimpleVector<int>& const_v = v;
+        SimpleVectorView const_view = const_v;
+        static_assert(std::is_same_v<decltype(const_view), SimpleVectorView<const int>>);
+        SimpleVectorView<const int> converted = view;
+        assert(converted == const_view && view == const_view);
+    }
+    {
+        const auto middle = view.Subview(2, 3);
+        assert(middle.GetSize() == 3 && middle[0] == 2 && middle[2] == 4);
+        assert(view.Subview(8).GetSize() == 2 && view.Subview(10).IsEmpty() && view.Subview(4, 100).GetSize() == 6);
+        assert(view.First(2) == SimpleVectorView<int>(v.begin(), 2) && view.Last(3)[0] == 7 && view.Last(20).GetSize() == 10);
+        try {
+            view.Subview(11);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+        try {
+            view.At(10);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+    }
+    {
+        const auto parts = view.Split(3);
+        assert(parts.GetSize() == 3 && parts[0].GetSize() == 4 && parts[1].GetSize() == 3 && parts[2].GetSize() == 3);
+        assert(parts[0].end() == parts[1].begin() && parts[2].end() == view.end());
+        assert(view.Split(20).GetSize() == 10 && SimpleVectorView<int>().Split(4).IsEmpty());
+        for (const auto& part : parts) {
+            ParallelForEach(part.begin(), part.end(), [](int& x) { x *= 2; });
+        }
+        assert(v[9] == 18);
+    }
+    {
+        SimpleVector<int> other{0, 2, 4, 7};
+        assert(view.First(3) == SimpleVectorView(other).First(3));
+        assert(view.First(4) < SimpleVectorView(other) && SimpleVectorView(other) > view.First(4));
+        assert(view.First(4) != SimpleVectorView(other) && view.First(3) <= SimpleVectorView(other));
+        assert(view.First(3) < view.First(4) && view >= view);
+    }
+    {
+        // Представление сравнивается с вектором, неявно преобразуя его в представление
+        SimpleVector<int> same = v;
+        const SimpleVector<int> longer{0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20};
+        assert(view == same && same == view && !(view != same) && SimpleVectorView<const int>(v) == same);
+        assert(view < longer && longer > view && view <= longer && longer >= view && view != longer);
+        assert(view.First(2) < same && same > view.First(2) && !(same < view) && same <= view);
+        SmallSimpleVector<int, 4> small{0, 2, 4};
+        assert(view.First(3) == small && small == view.First(3) && small < view);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+namespace {
+
+// Таблица квадратов, вычисленная вектором при компиляции и скопированная в std::array
+constexpr std::array<int, 8> SquaresTable() {
+    SimpleVector<int> v;
+    v.Reserve(2);
+    for (int i = 0; i < 8; ++i) {
+        v.PushBack(i * i);
+    }
+    v.Insert(v.begin(), -1);
+    v.Insert(v.begin() + 2, 3, v[1]);
+    v.Erase(v.begin(), v.begin() + 4);
+    std::array<int, 8> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = v.At(i);
+    }
+    return table;
+}
+
+constexpr bool ConstexprStringsWork() {
+    SimpleVector<std::string> v(2, "ab");
+    v.PushBack("cd");
+    v.Insert(v.begin(), v[2]);
+    v.Erase(v.begin() + 1);
+    SimpleVector<std::string> copy = v;
+    copy.Resize(5);
+    copy.PopBack();
+    copy.Resize(3);
+    SimpleVector<std::string> moved = std::move(copy);
+    return v.GetSize() == 3 && v[0] == "cd" && v[2] == "cd" && moved == v && copy.IsEmpty();
+}
+
+constexpr bool ConstexprComparisonsWork() {
+    const SimpleVector<int> a{1, 2, 3};
+    SimpleVector<int> b(3, 1);
+    b[1] = 2;
+    b[2] = 3;
+    b.EmplaceBack(0);
+    b.ShrinkToFit();
+    return a < b && a != b && b.GetCapacity() == 4 && a == SimpleVector<int>{1, 2, 3};
+}
+
+} // namespace
+#endif
+
+void TestConstexprSimpleVector() {
+    std::cout << "Test constexpr simple vector" << std::endl;
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+    constexpr auto table = SquaresTable();
+    static_assert(table[0] == 0 && table[1] == 1 && table[2] == 4 && table[7] == 49);
+    static_assert(ConstexprStringsWork());
+    static_assert(ConstexprComparisonsWork());
+    // Те же функции работают и во время выполнения программы
+    assert(SquaresTable() == table && ConstexprStringsWork() && ConstexprComparisonsWork());
+#endif
+    std::cout << "Done!" << std::endl;
+}
+
+void TestSoaSimpleVector() {
+    std::cout << "Test SoA simple vector" << std::endl;
+    using Table = SoaSimpleVector<int, double, std::string>;
+    Table table;
+    for (int i = 0; i < 10; ++i) {
+        table.PushBack(i, i * 0.5, std::to_string(i));
+    }
+    assert(table.GetSize() == 10 && table.GetCapacity() >= 10);
+    {
+        // Каждое поле лежит в отдельном выровненном непрерывном массиве
+        const auto ids = table.GetField<0>();
+        const auto prices = table.GetField<1>();
+        assert(ids.GetSize() == 10 && std::accumulate(ids.begin(), ids.end(), 0) == 45);
+        assert(reinterpret_cast<uintptr_t>(prices.begin()) % CACHE_LINE_ALIGNMENT == 0);
+        assert(&table[3].Get<1>() == prices.begin() + 3);
+        for (double& price : table.GetField<1>()) {
+            price *= 2;
+        }
+        assert(table[9].Get<1>() == 9.0);
+    }
+    {
+        // Строки доступны через ссылки и структурную привязку
+        for (auto [id, price, name] : table) {
+            price = id;
+            name += "!";
+        }
+        assert(table[4].Get<1>() == 4.0 && table.At(4).Get<2>() == "4!");
+        std::tuple<int, double, std::string> row = table[2];
+        assert(row == std::make_tuple(2, 2.0, "2!"s));
+        table[0] = table[1];
+        table[1] = std::make_tuple(-1, -1.0, "x"s);
+        assert(table[0].Get<0>() == 1 && table[1].Get<2>() == "x");
+        swap(table[0], table[1]);
+        assert(table[0].Get<0>() == -1 && table[1].Get<0>() == 1);
+        std::reverse(table.begin(), table.end());
+        assert(table[9].Get<0>() == -1 && table[0].Get<0>() == 9);
+        const Table& const_table = table;
+        int sum = 0;
+        for (const auto [id, price, name] : const_table) {
+            sum += id;
+        }
+        assert(sum == 9 + 8 + 7 + 6 + 5 + 4 + 3 + 2 + 1 - 1);
+        try {
+            const_table.At(10);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+    }
+    {
+        // Вставка и удаление сдвигают все поля вместе, в том числе значения из самого вектора
+        Table t;
+        t.Resize(3);
+        assert(t[2].Get<0>() == 0 && t[2].Get<2>().empty());
+        t[0] = std::make_tuple(7, 7.0, "seven"s);
+        t.Insert(t.begin() + 1, t[0].Get<0>(), t[0].Get<1>(), t[0].Get<2>());
+        t.Insert(t.begin(), 3, t[1].Get<0>(), 1.5, t[1].Get<2>());
+        t.Emplace(t.end(), 8, 8.0, "eight");
+        assert(t.GetSize() == 8 && t.GetField<0>()[3] == 7 && t.GetField<2>()[4] == "seven");
+        assert(t.GetField<1>()[0] == 1.5 && t[7].Get<2>() == "eight");
+        const auto it = t.Erase(t.begin(), t.begin() + 3);
+        assert(it == t.begin() && t.GetSize() == 5 && t[1].Get<2>() == "seven");
+        t.Erase(t.begin() + 2);
+        t.PopBack();
+        assert(t.GetSize() == 3 && t.GetField<2>()[2].empty());
+        Table copy = t;
+        assert(copy == t);
+        copy[0].Get<1>() = 0.5;
+        assert(copy != t);
+        copy.Reserve(100);
+        assert(copy.GetCapacity() == 100 && copy.GetField<0>()[1] == 7);
+        copy.ShrinkToFit();
+        assert(copy.GetCapacity() == 3);
+        t = std::move(copy);
+        assert(t[0].Get<1>() == 0.5 && copy.IsEmpty());
+        t.Clear();
+        assert(t.IsEmpty() && t.GetCapacity() == 3);
+    }
+    {
+        // Исключение при создании одного из полей не меняет вектор и не оставляет живых полей
+        CountedObject::alive = 0;
+        {
+            SoaSimpleVector<CountedObject, ThrowingFromInt> v;
+            v.EmplaceBack(CountedObject(), 1);
+            v.EmplaceBack(CountedObject(), 2);
+            // Сначала при росте вектора, затем при сдвиге строк внутри вместимости
+            for (size_t capacity : {size_t{2}, size_t{4}}) {
+                v.Reserve(capacity);
+                for (size_t pos : {size_t{0}, size_t{1}, size_t{2}}) {
+                    try {
+                        v.Emplace(v.begin() + pos, CountedObject(), -1);
+                        assert(false);
+                    } catch (const std::invalid_argument&) {
+                    }
+                    assert(v.GetSize() == 2 && v.GetCapacity() == capacity && CountedObject::alive == 2);
+                    assert(v[0].Get<1>().value == "1" && v[1].Get<1>().value == "2");
+                }
+            }
+        }
+        assert(CountedObject::alive == 0);
+    }
+    std::cout << "Done!" << std::endl;
+}
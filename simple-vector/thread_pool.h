@@ -0,0 +1,180 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Пул потоков с очередью задач у каждого рабочего потока и перехватом работы (work stealing).
+// Задача, поставленная из рабочего потока пула, попадает в его собственную очередь и
+// выполняется им же в порядке LIFO; простаивающие потоки забирают задачи из начала
+// чужих очередей. Поток, ожидающий завершения своих задач, может выполнять задачи пула
+// через RunPendingTask, поэтому вложенные параллельные вызовы не приводят к взаимоблокировке
+class ThreadPool {
+public:
+    // Запускает thread_count рабочих потоков (не меньше одного)
+    explicit ThreadPool(size_t thread_count = std::thread::hardware_concurrency());
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Дожидается выполнения всех поставленных задач и останавливает потоки
+    ~ThreadPool();
+
+    // Возвращает количество рабочих потоков
+    size_t GetThreadCount() const noexcept;
+
+    // Ставит задачу в очередь. Задача не должна выбрасывать исключений
+    void Submit(std::function<void()> task);
+
+    // Выполняет в вызывающем потоке одну задачу из очередей пула.
+    // Возвращает false, если задач не нашлось
+    bool RunPendingTask();
+
+    // Возвращает пул по умолчанию, создаваемый при первом обращении
+    static ThreadPool& Default();
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    SimpleVector<std::unique_ptr<TaskQueue>> queues_;
+    SimpleVector<std::thread> threads_;
+    std::atomic<size_t> pending_ = 0;
+    std::atomic<size_t> next_queue_ = 0;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+
+    // Пул и номер очереди рабочего потока, выполняющего текущий код
+    inline static thread_local ThreadPool* current_pool_ = nullptr;
+    inline static thread_local size_t current_queue_ = 0;
+
+    void WorkerLoop(size_t index);
+
+    // Забирает задачу с конца собственной очереди index
+    bool TryPop(size_t index, std::function<void()>& task);
+
+    // Забирает задачу из начала любой очереди, начиная со следующей за index
+    bool TrySteal(size_t index, std::function<void()>& task);
+};
+
+// ---------------------ThreadPool----------------------
+
+inline ThreadPool::ThreadPool(size_t thread_count) {
+    thread_count = std::max(thread_count, size_t{1});
+    queues_.Reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        queues_.EmplaceBack(std::make_unique<TaskQueue>());
+    }
+    threads_.Reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads_.EmplaceBack([this, i] {
+            WorkerLoop(i);
+        });
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(wake_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+inline size_t ThreadPool::GetThreadCount() const noexcept {
+    return threads_.GetSize();
+}
+
+inline void ThreadPool::Submit(std::function<void()> task) {
+    const size_t index = current_pool_ == this
+        ? current_queue_
+        : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.GetSize();
+    {
+        // Счётчик увеличивается под мьютексом очереди: задачу нельзя извлечь
+        // и уменьшить счётчик раньше, чем он учтёт её
+        std::lock_guard lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+        pending_.fetch_add(1);
+    }
+    {
+        // Поток, проверивший условие ожидания до увеличения счётчика, успеет
+        // заснуть до уведомления и не пропустит его
+        std::lock_guard lock(wake_mutex_);
+    }
+    wake_.notify_one();
+}
+
+inline bool ThreadPool::RunPendingTask() {
+    std::function<void()> task;
+    const size_t index = current_pool_ == this ? current_queue_ : 0;
+    if (TryPop(index, task) || TrySteal(index, task)) {
+        task();
+        return true;
+    }
+    return false;
+}
+
+inline ThreadPool& ThreadPool::Default() {
+    static ThreadPool pool;
+    return pool;
+}
+
+inline void ThreadPool::WorkerLoop(size_t index) {
+    current_pool_ = this;
+    current_queue_ = index;
+    while (true) {
+        std::function<void()> task;
+        if (TryPop(index, task) || TrySteal(index, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock lock(wake_mutex_);
+        wake_.wait(lock, [this] {
+            return stop_ || pending_.load() > 0;
+        });
+        if (stop_ && pending_.load() == 0) {
+            return;
+        }
+    }
+}
+
+inline bool ThreadPool::TryPop(size_t index, std::function<void()>& task) {
+    TaskQueue& queue = *queues_[index];
+    std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    pending_.fetch_sub(1);
+    return true;
+}
+
+inline bool ThreadPool::TrySteal(size_t index, std::function<void()>& task) {
+    const size_t queue_count = queues_.GetSize();
+    for (size_t offset = 1; offset <= queue_count; ++offset) {
+        TaskQueue& queue = *queues_[(index + offset) % queue_count];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            pending_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
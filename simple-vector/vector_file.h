@@ -0,0 +1,373 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Двоичный формат файла для векторов тривиально копируемых элементов.
+// Файл начинается с заголовка VectorFileHeader, за которым с позиции payload_offset
+// записаны байты элементов в том виде, в каком они лежат в памяти. Заголовок хранит
+// размер и выравнивание элемента, количество элементов и контрольную сумму содержимого
+// (simd::HashBytes), поэтому файл другого типа или повреждённый файл не будет прочитан.
+// Порядок байтов не преобразуется: файл читается на машине с тем же порядком байтов.
+//
+//     SaveTo(table, "table.bin");
+//     SimpleVector<Entry> copy = LoadFrom<Entry>("table.bin");   // одно чтение в один буфер
+//     MappedSimpleVector<Entry> view("table.bin");               // без копирования
+
+struct VectorFileHeader {
+    // "SVECTOR" и нулевой байт, прочитанные как число: при другом порядке байтов не совпадут
+    static constexpr uint64_t MAGIC = 0x00524F5443455653ull;
+    static constexpr uint32_t VERSION = 1;
+
+    uint64_t magic = MAGIC;
+    uint32_t version = VERSION;
+    // Смещение содержимого от начала файла, кратное выравниванию элемента
+    uint32_t payload_offset = 0;
+    uint64_t element_size = 0;
+    uint64_t element_alignment = 0;
+    uint64_t count = 0;
+    uint64_t checksum = 0;
+};
+
+// Записывает элементы vector в файл path, заменяя его содержимое.
+// При ошибке ввода-вывода выбрасывает std::system_error
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+void SaveTo(const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& vector, const std::string& path);
+
+// Читает вектор из файла path, записанного SaveTo. Память выделяется один раз под точный
+// размер, и содержимое читается прямо в неё. При ошибке ввода-вывода выбрасывает
+// std::system_error, если файл не подходит для Type или повреждён — std::runtime_error
+template <typename Type, typename Allocator = MallocAllocator<Type>, typename GrowthPolicy = DoublingGrowth,
+          typename ShrinkPolicy = NeverShrink>
+SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy> LoadFrom(const std::string& path, const Allocator& alloc = Allocator());
+
+// Вектор только для чтения, отображающий файл, записанный SaveTo, в память (mmap).
+// Элементы не копируются: страницы файла читаются ядром при первом обращении и
+// разделяются всеми процессами, отображающими тот же файл. Конструктор проверяет
+// заголовок, но не контрольную сумму, чтобы не читать файл целиком; её проверяет VerifyChecksum.
+// Файл не должен изменяться, пока существует отображение
+template <typename Type>
+class MappedSimpleVector {
+    static_assert(std::is_trivially_copyable_v<Type>, "MappedSimpleVector requires a trivially copyable Type");
+
+public:
+    using ConstIterator = const Type*;
+
+    MappedSimpleVector() noexcept = default;
+
+    // Отображает файл path. При ошибке ввода-вывода выбрасывает std::system_error,
+    // если файл не подходит для Type — std::runtime_error
+    explicit MappedSimpleVector(const std::string& path);
+
+    MappedSimpleVector(const MappedSimpleVector&) = delete;
+    MappedSimpleVector& operator=(const MappedSimpleVector&) = delete;
+
+    MappedSimpleVector(MappedSimpleVector&& other) noexcept;
+    MappedSimpleVector& operator=(MappedSimpleVector&& rhs) noexcept;
+
+    ~MappedSimpleVector();
+
+    size_t GetSize() const noexcept;
+    bool IsEmpty() const noexcept;
+
+    // Сообщает, совпадает ли контрольная сумма содержимого с записанной в заголовке.
+    // Читает все страницы файла
+    bool VerifyChecksum() const noexcept;
+
+    const Type& operator[](size_t index) const noexcept;
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const;
+
+    ConstIterator begin() const noexcept;
+    ConstIterator end() const noexcept;
+    ConstIterator cbegin() const noexcept;
+    ConstIterator cend() const noexcept;
+
+    // Копирует элементы в SimpleVector
+    SimpleVector<Type> ToSimpleVector() const;
+
+private:
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    const Type* data_ = nullptr;
+    size_t size_ = 0;
+    uint64_t checksum_ = 0;
+};
+
+namespace vector_file {
+
+// Владеет дескриптором открытого файла
+class FileDescriptor {
+public:
+    FileDescriptor(const std::string& path, int flags, mode_t mode = 0)
+        : fd_(::open(path.c_str(), flags | O_CLOEXEC, mode)) {
+        if (fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+    }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    ~FileDescriptor() {
+        ::close(fd_);
+    }
+
+    int Get() const noexcept {
+        return fd_;
+    }
+
+    // Возвращает размер файла в байтах
+    size_t GetFileSize(const std::string& path) const {
+        struct stat info;
+        if (::fstat(fd_, &info) != 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot stat " + path);
+        }
+        return static_cast<size_t>(info.st_size);
+    }
+
+private:
+    int fd_;
+};
+
+template <typename Type>
+constexpr size_t PayloadOffset() noexcept {
+    constexpr size_t alignment = alignof(Type) > 64 ? alignof(Type) : 64;
+    return (sizeof(VectorFileHeader) + alignment - 1) / alignment * alignment;
+}
+
+// Проверяет, что header описывает вектор Type и файл размером file_size вмещает его содержимое
+template <typename Type>
+void ValidateHeader(const VectorFileHeader& header, size_t file_size, const std::string& path) {
+    if (header.magic != VectorFileHeader::MAGIC) {
+        throw std::runtime_error(path + " is not a SimpleVector file or has a different byte order");
+    }
+    if (header.version != VectorFileHeader::VERSION) {
+        throw std::runtime_error(path + " has unsupported format version " + std::to_string(header.version));
+    }
+    if (header.element_size != sizeof(Type) || header.element_alignment != alignof(Type)) {
+        throw std::runtime_error(path + " stores elements of size " + std::to_string(header.element_size)
+                                 + " and alignment " + std::to_string(header.element_alignment));
+    }
+    if (header.payload_offset < sizeof(VectorFileHeader) || header.payload_offset % alignof(Type) != 0
+        || header.payload_offset > file_size || header.count > (file_size - header.payload_offset) / sizeof(Type)) {
+        throw std::runtime_error(path + " is truncated or has a corrupted header");
+    }
+}
+
+// Записывает size байт data целиком
+inline void WriteAll(int fd, const void* data, size_t size, const std::string& path) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "Cannot write " + path);
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+// Читает ровно size байт в data. Ядро может вернуть меньше запрошенного, поэтому
+// большое содержимое дочитывается в цикле
+inline void ReadAll(int fd, void* data, size_t size, const std::string& path) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        const ssize_t received = ::read(fd, bytes, size);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "Cannot read " + path);
+        }
+        if (received == 0) {
+            throw std::runtime_error(path + " is truncated");
+        }
+        bytes += received;
+        size -= static_cast<size_t>(received);
+    }
+}
+
+} // namespace vector_file
+
+// ----------------------SaveTo----------------------
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+void SaveTo(const SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy>& vector, const std::string& path) {
+    static_assert(std::is_trivially_copyable_v<Type>, "SaveTo requires a trivially copyable Type");
+    const size_t bytes = vector.GetSize() * sizeof(Type);
+    VectorFileHeader header;
+    header.payload_offset = static_cast<uint32_t>(vector_file::PayloadOffset<Type>());
+    header.element_size = sizeof(Type);
+    header.element_alignment = alignof(Type);
+    header.count = vector.GetSize();
+    header.checksum = simd::HashBytes(reinterpret_cast<const unsigned char*>(vector.begin()), bytes);
+
+    unsigned char prefix[vector_file::PayloadOffset<Type>()] = {};
+    std::memcpy(prefix, &header, sizeof(header));
+    vector_file::FileDescriptor file(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    vector_file::WriteAll(file.Get(), prefix, sizeof(prefix), path);
+    vector_file::WriteAll(file.Get(), vector.begin(), bytes, path);
+}
+
+// ---------------------LoadFrom---------------------
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ShrinkPolicy>
+SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy> LoadFrom(const std::string& path, const Allocator& alloc) {
+    static_assert(std::is_trivially_copyable_v<Type>, "LoadFrom requires a trivially copyable Type");
+    vector_file::FileDescriptor file(path, O_RDONLY);
+    const size_t file_size = file.GetFileSize(path);
+    VectorFileHeader header;
+    if (file_size < sizeof(header)) {
+        throw std::runtime_error(path + " is not a SimpleVector file");
+    }
+    vector_file::ReadAll(file.Get(), &header, sizeof(header), path);
+    vector_file::ValidateHeader<Type>(header, file_size, path);
+    if (::lseek(file.Get(), header.payload_offset, SEEK_SET) < 0) {
+        throw std::system_error(errno, std::generic_category(), "Cannot seek " + path);
+    }
+
+    const size_t count = static_cast<size_t>(header.count);
+    SimpleVector<Type, Allocator, GrowthPolicy, ShrinkPolicy> result(alloc);
+    result.AppendInPlace(count, [&](Type* dest) {
+        vector_file::ReadAll(file.Get(), dest, count * sizeof(Type), path);
+    });
+    if (simd::HashBytes(reinterpret_cast<const unsigned char*>(result.begin()), count * sizeof(Type)) != header.checksum) {
+        throw std::runtime_error(path + " is corrupted: checksum mismatch");
+    }
+    return result;
+}
+
+// ----------------MappedSimpleVector----------------
+
+template <typename Type>
+MappedSimpleVector<Type>::MappedSimpleVector(const std::string& path) {
+    static_assert(alignof(Type) <= 4096, "Mapped elements cannot be aligned stricter than a page");
+    vector_file::FileDescriptor file(path, O_RDONLY);
+    const size_t file_size = file.GetFileSize(path);
+    if (file_size < sizeof(VectorFileHeader)) {
+        throw std::runtime_error(path + " is not a SimpleVector file");
+    }
+    // Отображение остаётся действительным после закрытия дескриптора
+    void* mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file.Get(), 0);
+    if (mapping == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "Cannot map " + path);
+    }
+    VectorFileHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    try {
+        vector_file::ValidateHeader<Type>(header, file_size, path);
+    } catch (...) {
+        ::munmap(mapping, file_size);
+        throw;
+    }
+    mapping_ = mapping;
+    mapping_size_ = file_size;
+    data_ = reinterpret_cast<const Type*>(static_cast<const unsigned char*>(mapping) + header.payload_offset);
+    size_ = static_cast<size_t>(header.count);
+    checksum_ = header.checksum;
+}
+
+template <typename Type>
+MappedSimpleVector<Type>::MappedSimpleVector(MappedSimpleVector&& other) noexcept
+    : mapping_(std::exchange(other.mapping_, nullptr))
+    , mapping_size_(std::exchange(other.mapping_size_, 0))
+    , data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+    , checksum_(std::exchange(other.checksum_, 0)) {
+}
+
+template <typename Type>
+MappedSimpleVector<Type>& MappedSimpleVector<Type>::operator=(MappedSimpleVector&& rhs) noexcept {
+    if (this != &rhs) {
+        MappedSimpleVector temp(std::move(rhs));
+        std::swap(mapping_, temp.mapping_);
+        std::swap(mapping_size_, temp.mapping_size_);
+        std::swap(data_, temp.data_);
+        std::swap(size_, temp.size_);
+        std::swap(checksum_, temp.checksum_);
+    }
+    return *this;
+}
+
+template <typename Type>
+MappedSimpleVector<Type>::~MappedSimpleVector() {
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, mapping_size_);
+    }
+}
+
+template <typename Type>
+size_t MappedSimpleVector<Type>::GetSize() const noexcept {
+    return size_;
+}
+
+template <typename Type>
+bool MappedSimpleVector<Type>::IsEmpty() const noexcept {
+    return size_ == 0;
+}
+
+template <typename Type>
+bool MappedSimpleVector<Type>::VerifyChecksum() const noexcept {
+    return simd::HashBytes(reinterpret_cast<const unsigned char*>(data_), size_ * sizeof(Type)) == checksum_;
+}
+
+template <typename Type>
+const Type& MappedSimpleVector<Type>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return data_[index];
+}
+
+template <typename Type>
+const Type& MappedSimpleVector<Type>::At(size_t index) const {
+    if (!(index < size_))
+        throw std::out_of_range("The index value is out of range");
+    return data_[index];
+}
+
+template <typename Type>
+typename MappedSimpleVector<Type>::ConstIterator MappedSimpleVector<Type>::begin() const noexcept {
+    return data_;
+}
+
+template <typename Type>
+typename MappedSimpleVector<Type>::ConstIterator MappedSimpleVector<Type>::end() const noexcept {
+    return data_ + size_;
+}
+
+template <typename Type>
+typename MappedSimpleVector<Type>::ConstIterator MappedSimpleVector<Type>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename Type>
+typename MappedSimpleVector<Type>::ConstIterator MappedSimpleVector<Type>::cend() const noexcept {
+    return end();
+}
+
+template <typename Type>
+SimpleVector<Type> MappedSimpleVector<Type>::ToSimpleVector() const {
+    SimpleVector<Type> result;
+    result.AppendInPlace(size_, [this](Type* dest) {
+        std::memcpy(static_cast<void*>(dest), data_, size_ * sizeof(Type));
+    });
+    return result;
+}